@@ -0,0 +1,53 @@
+#include "AllocationCounter.hpp"
+
+#ifdef JSON_STATS
+// The library already replaces the allocation functions to count them.
+#include <core/Stats.hpp>
+
+uint64_t allocationCount() {
+    return heapCounters().allocations;
+}
+#else
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> allocations{0};
+
+    void* allocate(const size_t size) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(const size_t size, const std::align_val_t alignment) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        const auto align = static_cast<size_t>(alignment);
+        if (void* memory = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+uint64_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(const size_t size) { return allocate(size); }
+void* operator new[](const size_t size) { return allocate(size); }
+void* operator new(const size_t size, const std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](const size_t size, const std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { std::free(memory); }
+#endif
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Number of global operator new calls made by this process so far.
+ *
+ * The benchmark binary replaces the global allocation functions to keep
+ * this count; divide a difference by the documents processed to get
+ * allocations per document.
+ */
+uint64_t allocationCount();
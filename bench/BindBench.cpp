@@ -0,0 +1,54 @@
+#include "AllocationCounter.hpp"
+#include "CorpusGenerator.hpp"
+
+#include <benchmark/benchmark.h>
+#include <core/Bind.hpp>
+#include <core/Parser.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+    enum class LogLevel { DEBUG, INFO, WARN, ERROR };
+    JSON_ENUM(LogLevel, DEBUG, INFO, WARN, ERROR)
+
+    struct LogRecord {
+        std::string ts;
+        LogLevel level{};
+        std::string service;
+        std::string message;
+        std::string trace;
+    };
+    JSON_FIELDS(LogRecord, ts, level, service, message, trace)
+
+    const std::string& logCorpus() {
+        static const std::string corpus = generateCorpus(Corpus::StringLog, 1 << 20);
+        return corpus;
+    }
+
+    void BM_LogsTyped(benchmark::State& state) {
+        const std::string& json = logCorpus();
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(parse<std::vector<LogRecord>>(json));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+        state.counters["allocs/doc"] = benchmark::Counter(
+            static_cast<double>(allocationCount() - before), benchmark::Counter::kAvgIterations);
+    }
+
+    void BM_LogsDom(benchmark::State& state) {
+        const std::string& json = logCorpus();
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            Parser parser(json);
+            benchmark::DoNotOptimize(parser.parse());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+        state.counters["allocs/doc"] = benchmark::Counter(
+            static_cast<double>(allocationCount() - before), benchmark::Counter::kAvgIterations);
+    }
+}
+
+BENCHMARK(BM_LogsTyped)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LogsDom)->Unit(benchmark::kMillisecond);
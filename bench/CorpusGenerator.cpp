@@ -0,0 +1,184 @@
+#include "CorpusGenerator.hpp"
+
+#include <cstdio>
+#include <random>
+
+namespace {
+    class Generator {
+    public:
+        explicit Generator(const uint32_t seed) : rng_(seed) {
+        }
+
+        size_t integer(const size_t low, const size_t high) {
+            return std::uniform_int_distribution<size_t>(low, high)(rng_);
+        }
+
+        double real(const double low, const double high) {
+            return std::uniform_real_distribution<double>(low, high)(rng_);
+        }
+
+        std::string word() {
+            static constexpr std::string_view syllables[] = {
+                "lo", "rem", "ip", "sum", "do", "lor", "sit", "am", "et", "con", "sec", "tet", "ur", "ad", "pi"
+            };
+            std::string result;
+            for (size_t i = integer(1, 4); i > 0; --i) {
+                result += syllables[integer(0, std::size(syllables) - 1)];
+            }
+            return result;
+        }
+
+        std::string sentence(const size_t words) {
+            std::string result;
+            for (size_t i = 0; i < words; ++i) {
+                result += i == 0 ? "" : " ";
+                result += word();
+            }
+            return result;
+        }
+
+        std::string quoted(const std::string& text) {
+            return '"' + text + '"';
+        }
+
+        std::string number() {
+            char digits[32];
+            const int length = std::snprintf(digits, sizeof(digits), "%.17g", real(-1e6, 1e6));
+            return {digits, static_cast<size_t>(length)};
+        }
+
+    private:
+        std::mt19937 rng_;
+    };
+
+    std::string deepNesting(Generator& gen, const size_t targetBytes) {
+        std::string out = "[";
+        while (out.size() < targetBytes) {
+            const size_t depth = gen.integer(100, 500);
+            for (size_t d = 0; d < depth; ++d) {
+                out += d % 2 ? R"({"level":)" : "[";
+            }
+            out += gen.quoted(gen.word());
+            for (size_t d = depth; d > 0; --d) {
+                out += (d - 1) % 2 ? "}" : "]";
+            }
+            out += ',';
+        }
+        out.back() = ']';
+        return out;
+    }
+
+    std::string wideObject(Generator& gen, const size_t targetBytes) {
+        std::string out = "{";
+        for (size_t i = 0; out.size() < targetBytes; ++i) {
+            out += gen.quoted(gen.word() + std::to_string(i)) + ":";
+            out += i % 3 == 0 ? gen.quoted(gen.word()) : std::to_string(gen.integer(0, 1000000));
+            out += ',';
+        }
+        out.back() = '}';
+        return out;
+    }
+
+    std::string numbers(Generator& gen, const size_t targetBytes) {
+        std::string out = "[";
+        for (size_t i = 0; out.size() < targetBytes; ++i) {
+            out += i % 2 ? gen.number() : std::to_string(gen.integer(0, uint64_t{1} << 62));
+            out += ',';
+        }
+        out.back() = ']';
+        return out;
+    }
+
+    std::string stringLog(Generator& gen, const size_t targetBytes) {
+        static constexpr std::string_view levels[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+        std::string out = "[";
+        for (size_t i = 0; out.size() < targetBytes; ++i) {
+            out += R"({"ts":")" + std::to_string(1700000000000 + i * 17) + R"(","level":")";
+            out += levels[gen.integer(0, 3)];
+            out += R"(","service":)" + gen.quoted(gen.word()) + R"(,"message":)";
+            out += gen.quoted(gen.sentence(gen.integer(8, 40))) + R"(,"trace":)" + gen.quoted(gen.sentence(3)) + "},";
+        }
+        out.back() = ']';
+        return out;
+    }
+
+    std::string twitter(Generator& gen, const size_t targetBytes) {
+        std::string out = R"({"statuses":[)";
+        for (size_t i = 0; out.size() < targetBytes; ++i) {
+            const uint64_t id = 505874924095815681ULL + i * 7919;
+            out += R"({"created_at":"Sun Aug 31 00:29:15 +0000 2014","id":)" + std::to_string(id);
+            out += R"(,"id_str":")" + std::to_string(id) + R"(","text":)" + gen.quoted(gen.sentence(gen.integer(5, 20)));
+            out += R"(,"truncated":false,"entities":{"hashtags":[],"urls":[],"user_mentions":[{"screen_name":)";
+            out += gen.quoted(gen.word()) + R"(,"id":)" + std::to_string(gen.integer(1, 1u << 30)) + R"(,"indices":[0,12]}]})";
+            out += R"(,"user":{"id":)" + std::to_string(gen.integer(1, 1u << 30)) + R"(,"name":)" + gen.quoted(gen.word());
+            out += R"(,"followers_count":)" + std::to_string(gen.integer(0, 100000));
+            out += R"(,"verified":false,"profile_image_url":"http://pbs.twimg.com/profile_images/)" + gen.word() + R"(.png"})";
+            out += R"(,"retweet_count":)" + std::to_string(gen.integer(0, 1000)) + R"(,"favorited":false,"lang":"ja"},)";
+        }
+        out.back() = ']';
+        out += '}';
+        return out;
+    }
+
+    std::string canada(Generator& gen, const size_t targetBytes) {
+        std::string out = R"({"type":"FeatureCollection","features":[{"type":"Feature","properties":{"name":"Canada"},)";
+        out += R"("geometry":{"type":"Polygon","coordinates":[)";
+        while (out.size() < targetBytes) {
+            out += '[';
+            for (size_t i = gen.integer(50, 500); i > 0; --i) {
+                char pair[64];
+                const int length = std::snprintf(pair, sizeof(pair), "[%.15g,%.15g],", gen.real(-141.0, -52.0), gen.real(41.0, 83.0));
+                out.append(pair, static_cast<size_t>(length));
+            }
+            out.back() = ']';
+            out += ',';
+        }
+        out.back() = ']';
+        out += "}}]}";
+        return out;
+    }
+
+    std::string citm(Generator& gen, const size_t targetBytes) {
+        std::string out = R"({"areaNames":{"205705993":"Arrière-scène central","205705994":"1er balcon central"},"events":{)";
+        for (size_t i = 0; out.size() < targetBytes; ++i) {
+            const std::string id = std::to_string(138586341 + i);
+            out += gen.quoted(id) + R"(:{"description":null,"id":)" + id + R"(,"logo":null,"name":)" + gen.quoted(gen.sentence(3));
+            out += R"(,"subTopicIds":[337184269,337184283],"subjectCode":null,"subtitle":null,"topicIds":[)";
+            for (size_t t = gen.integer(1, 6); t > 0; --t) {
+                out += std::to_string(324846099 + gen.integer(0, 1000)) + ",";
+            }
+            out.back() = ']';
+            out += "},";
+        }
+        out.back() = '}';
+        out += R"(,"seatCategoryNames":{"338937235":"Balcon","338937236":"Parterre"}})";
+        return out;
+    }
+}
+
+std::string_view corpusName(const Corpus corpus) {
+    switch (corpus) {
+        case Corpus::DeepNesting: return "deep";
+        case Corpus::WideObject: return "wide";
+        case Corpus::Numbers: return "numbers";
+        case Corpus::StringLog: return "strings";
+        case Corpus::Twitter: return "twitter";
+        case Corpus::Canada: return "canada";
+        case Corpus::Citm: return "citm";
+    }
+    return "unknown";
+}
+
+std::string generateCorpus(const Corpus corpus, const size_t targetBytes, const uint32_t seed) {
+    Generator gen(seed);
+    switch (corpus) {
+        case Corpus::DeepNesting: return deepNesting(gen, targetBytes);
+        case Corpus::WideObject: return wideObject(gen, targetBytes);
+        case Corpus::Numbers: return numbers(gen, targetBytes);
+        case Corpus::StringLog: return stringLog(gen, targetBytes);
+        case Corpus::Twitter: return twitter(gen, targetBytes);
+        case Corpus::Canada: return canada(gen, targetBytes);
+        case Corpus::Citm: return citm(gen, targetBytes);
+    }
+    return {};
+}
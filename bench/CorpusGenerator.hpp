@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Shapes of synthetic JSON used by the benchmarks.
+ */
+enum class Corpus {
+    DeepNesting, ///< Arrays and objects nested hundreds of levels deep.
+    WideObject, ///< A single object with tens of thousands of members.
+    Numbers, ///< Arrays of integers and doubles.
+    StringLog, ///< Log records dominated by long string messages.
+    Twitter, ///< Status objects with nested users, entities and 64-bit ids, like twitter.json.
+    Canada, ///< GeoJSON polygons of coordinate pairs, like canada.json.
+    Citm ///< Event catalogue with id maps and integer arrays, like citm_catalog.json.
+};
+
+std::string_view corpusName(Corpus corpus);
+
+/**
+ * @brief Generates a corpus of roughly the requested size.
+ *
+ * Output depends only on the arguments, so runs are comparable across
+ * machines and commits.
+ */
+std::string generateCorpus(Corpus corpus, size_t targetBytes, uint32_t seed = 42);
@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <core/Number.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    const std::vector<std::string_view>& numberCorpus() {
+        static const std::vector<std::string_view> corpus = {
+            "0", "42", "-17", "8419000", "1234567890123", "9007199254740993",
+            "40.7128", "-74.0060", "3.141592653589793", "2.5E+3", "1e-7", "-0.000123",
+            "6.02214076e23", "1.7976931348623157e308", "123456.789", "0.1",
+        };
+        return corpus;
+    }
+
+    void BM_NumberStod(benchmark::State& state) {
+        const auto& corpus = numberCorpus();
+        for (auto _: state) {
+            for (const std::string_view text: corpus) {
+                benchmark::DoNotOptimize(std::stod(std::string(text)));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(corpus.size()));
+    }
+
+    void BM_NumberParseJsonNumber(benchmark::State& state) {
+        const auto& corpus = numberCorpus();
+        for (auto _: state) {
+            for (const std::string_view text: corpus) {
+                benchmark::DoNotOptimize(parseJsonNumber(text));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(corpus.size()));
+    }
+
+    void BM_NumberValidateAndParse(benchmark::State& state) {
+        const auto& corpus = numberCorpus();
+        for (auto _: state) {
+            for (const std::string_view text: corpus) {
+                benchmark::DoNotOptimize(isJsonNumber(text));
+                benchmark::DoNotOptimize(parseJsonNumber(text));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(corpus.size()));
+    }
+}
+
+BENCHMARK(BM_NumberStod);
+BENCHMARK(BM_NumberParseJsonNumber);
+BENCHMARK(BM_NumberValidateAndParse);
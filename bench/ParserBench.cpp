@@ -0,0 +1,388 @@
+#include "AllocationCounter.hpp"
+#include "CorpusGenerator.hpp"
+
+#include <benchmark/benchmark.h>
+#include <core/Cbor.hpp>
+#include <core/Document.hpp>
+#include <core/FileReader.hpp>
+#include <core/JsonPath.hpp>
+#include <core/LazyDocument.hpp>
+#include <core/ParallelArray.hpp>
+#include <core/Parser.hpp>
+#include <core/StructuralIndex.hpp>
+#include <core/Tape.hpp>
+#include <core/TapeCache.hpp>
+#include <core/Tokenizer.hpp>
+#include <core/Validate.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace {
+    constexpr size_t CorpusBytes = 1 << 20;
+
+    const std::string& corpus(const Corpus kind) {
+        static std::map<Corpus, std::string> cache;
+        auto it = cache.find(kind);
+        if (it == cache.end()) {
+            it = cache.emplace(kind, generateCorpus(kind, CorpusBytes)).first;
+        }
+        return it->second;
+    }
+
+    const std::string& corpusFile(const Corpus kind) {
+        static std::map<Corpus, std::string> paths;
+        auto it = paths.find(kind);
+        if (it == paths.end()) {
+            const auto path = std::filesystem::temp_directory_path() /
+                              ("jsonparser-bench-" + std::string(corpusName(kind)) + ".json");
+            std::ofstream(path, std::ios::binary) << corpus(kind);
+            it = paths.emplace(kind, path.string()).first;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Records throughput, documents per second and allocations per document.
+     */
+    void report(benchmark::State& state, const size_t bytes, const uint64_t allocationsBefore) {
+        const auto documents = static_cast<int64_t>(state.iterations());
+        state.SetBytesProcessed(documents * static_cast<int64_t>(bytes));
+        state.SetItemsProcessed(documents);
+        state.counters["allocs/doc"] = benchmark::Counter(
+            static_cast<double>(allocationCount() - allocationsBefore), benchmark::Counter::kAvgIterations);
+    }
+
+    void BM_FileRead(benchmark::State& state, const Corpus kind) {
+        const std::string& path = corpusFile(kind);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(FileReader::read(path));
+        }
+        report(state, corpus(kind).size(), before);
+    }
+
+    void BM_StructuralIndex(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            StructuralIndex index(json);
+            benchmark::DoNotOptimize(index.size());
+        }
+        report(state, json.size(), before);
+    }
+
+    void BM_Tokenize(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            Tokenizer tokenizer(json);
+            benchmark::DoNotOptimize(tokenizer.tokenize());
+        }
+        report(state, json.size(), before);
+    }
+
+    void BM_ParseDom(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            Parser parser(json);
+            benchmark::DoNotOptimize(parser.parse());
+        }
+        report(state, json.size(), before);
+    }
+
+    void BM_ParseDomReused(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        Parser parser;
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            parser.reset(json);
+            benchmark::DoNotOptimize(parser.parse());
+        }
+        report(state, json.size(), before);
+    }
+
+    void BM_SelectPath(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const JsonPath path = JsonPath::compile("$..id");
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(path.select(json));
+        }
+        report(state, json.size(), before);
+    }
+
+    void BM_EncodeCbor(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const auto root = Parser(json).parse();
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(encodeCbor(*root));
+        }
+        report(state, json.size(), before);
+    }
+
+    /**
+     * Throughput is counted in bytes of JSON text, so that it compares
+     * directly with BM_ParseDom.
+     */
+    void BM_DecodeCbor(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const std::string bytes = encodeCbor(*Parser(json).parse());
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(decodeCbor(bytes));
+        }
+        report(state, json.size(), before);
+        state.counters["size/json"] = static_cast<double>(bytes.size()) / static_cast<double>(json.size());
+    }
+
+    void BM_ParseParallel(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        WorkerPool pool;
+        ParallelArrayOptions options;
+        options.pool = &pool;
+        options.chunkBytes = 64 * 1024;
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(parseArrayParallel(json, options));
+        }
+        report(state, json.size(), before);
+    }
+
+    void BM_ParseDocument(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(Document::parse(json));
+        }
+        report(state, json.size(), before);
+    }
+
+    void BM_ParseTape(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(Tape::parse(json));
+        }
+        report(state, json.size(), before);
+    }
+
+    void BM_ParseTapeFile(benchmark::State& state, const Corpus kind) {
+        const std::string& path = corpusFile(kind);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(Tape::parseFile(path));
+        }
+        report(state, corpus(kind).size(), before);
+    }
+
+    /**
+     * Loads that hit a warm image, verifying the content hash, to compare
+     * with BM_ParseTapeFile.
+     */
+    void BM_LoadCachedTape(benchmark::State& state, const Corpus kind) {
+        const std::string& path = corpusFile(kind);
+        const TapeCache cache((std::filesystem::temp_directory_path() / "jsonparser-bench-tapes").string());
+        (void) cache.load(path);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(cache.load(path));
+        }
+        report(state, corpus(kind).size(), before);
+    }
+
+    /**
+     * @brief Visits every value of an already parsed document, summing numbers and string lengths.
+     */
+    double visit(const ValueRef value) {
+        switch (value.type()) {
+            case DomType::Object: {
+                double sum = 0;
+                for (const DomMember& member: value.members()) {
+                    sum += visit(member.value);
+                }
+                return sum;
+            }
+            case DomType::Array: {
+                double sum = 0;
+                for (const DomNode& element: value.elements()) {
+                    sum += visit(element);
+                }
+                return sum;
+            }
+            case DomType::String: return static_cast<double>(value.asString().size());
+            case DomType::Number: return value.asNumber();
+            default: return 1;
+        }
+    }
+
+    double visit(const TapeRef value) {
+        switch (value.type()) {
+            case DomType::Object: {
+                double sum = 0;
+                for (const auto& [key, member]: value.members()) {
+                    sum += visit(member);
+                }
+                return sum;
+            }
+            case DomType::Array: {
+                double sum = 0;
+                for (const TapeRef element: value.elements()) {
+                    sum += visit(element);
+                }
+                return sum;
+            }
+            case DomType::String: return static_cast<double>(value.asString().size());
+            case DomType::Number: return value.asNumber();
+            default: return 1;
+        }
+    }
+
+    void BM_TraverseDocument(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const Document document = Document::parse(json);
+        for (auto _: state) {
+            benchmark::DoNotOptimize(visit(document.root()));
+        }
+        report(state, json.size(), allocationCount());
+    }
+
+    void BM_TraverseTape(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const Tape tape = Tape::parse(json);
+        for (auto _: state) {
+            benchmark::DoNotOptimize(visit(tape.root()));
+        }
+        report(state, json.size(), allocationCount());
+    }
+
+    void BM_Validate(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            benchmark::DoNotOptimize(validate(json));
+        }
+        report(state, json.size(), before);
+    }
+
+    void BM_LazyIndex(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        const uint64_t before = allocationCount();
+        for (auto _: state) {
+            LazyDocument document(json);
+            benchmark::DoNotOptimize(document.root().type());
+        }
+        report(state, json.size(), before);
+    }
+
+    /**
+     * @brief Rejecting malformed input through exceptions versus through std::expected.
+     */
+    const std::string& malformedInput() {
+        static const std::string json = R"({"id": 42, "name": "client", "tags": ["a", "b"], "score": 1.5,, "ok": true})";
+        return json;
+    }
+
+    void BM_RejectThrowing(benchmark::State& state) {
+        for (auto _: state) {
+            try {
+                benchmark::DoNotOptimize(Document::parse(malformedInput()));
+            } catch (const ParseException& ex) {
+                benchmark::DoNotOptimize(ex.error().offset);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    void BM_RejectExpected(benchmark::State& state) {
+        for (auto _: state) {
+            const auto document = Document::tryParse(malformedInput());
+            benchmark::DoNotOptimize(document.error().offset);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    /**
+     * @brief Times only the destruction of a parsed tree; building it is excluded.
+     */
+    void BM_TeardownDom(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        for (auto _: state) {
+            state.PauseTiming();
+            auto root = Parser(json).parse();
+            state.ResumeTiming();
+            root.reset();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    void BM_TeardownDocument(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        for (auto _: state) {
+            state.PauseTiming();
+            auto document = std::make_unique<Document>(Document::parse(json));
+            state.ResumeTiming();
+            document.reset();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    void BM_TeardownTape(benchmark::State& state, const Corpus kind) {
+        const std::string& json = corpus(kind);
+        for (auto _: state) {
+            state.PauseTiming();
+            auto tape = std::make_unique<Tape>(Tape::parse(json));
+            state.ResumeTiming();
+            tape.reset();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    void registerAll() {
+        using Benchmark = void (*)(benchmark::State&, Corpus);
+        const std::pair<const char*, Benchmark> benchmarks[] = {
+            {"BM_FileRead", BM_FileRead},
+            {"BM_StructuralIndex", BM_StructuralIndex},
+            {"BM_Tokenize", BM_Tokenize},
+            {"BM_ParseDom", BM_ParseDom},
+            {"BM_ParseDomReused", BM_ParseDomReused},
+            {"BM_SelectPath", BM_SelectPath},
+            {"BM_EncodeCbor", BM_EncodeCbor},
+            {"BM_DecodeCbor", BM_DecodeCbor},
+            {"BM_ParseParallel", BM_ParseParallel},
+            {"BM_ParseDocument", BM_ParseDocument},
+            {"BM_ParseTape", BM_ParseTape},
+            {"BM_ParseTapeFile", BM_ParseTapeFile},
+            {"BM_LoadCachedTape", BM_LoadCachedTape},
+            {"BM_TraverseDocument", BM_TraverseDocument},
+            {"BM_TraverseTape", BM_TraverseTape},
+            {"BM_Validate", BM_Validate},
+            {"BM_LazyIndex", BM_LazyIndex},
+            {"BM_TeardownDom", BM_TeardownDom},
+            {"BM_TeardownDocument", BM_TeardownDocument},
+            {"BM_TeardownTape", BM_TeardownTape},
+        };
+        constexpr Corpus corpora[] = {
+            Corpus::DeepNesting, Corpus::WideObject, Corpus::Numbers, Corpus::StringLog,
+            Corpus::Twitter, Corpus::Canada, Corpus::Citm
+        };
+        for (const auto& [name, function]: benchmarks) {
+            for (const Corpus kind: corpora) {
+                benchmark::RegisterBenchmark((std::string(name) + "/" + std::string(corpusName(kind))).c_str(), function, kind)
+                        ->Unit(benchmark::kMillisecond);
+            }
+        }
+    }
+
+    const bool registered = (registerAll(), true);
+}
+
+BENCHMARK(BM_RejectThrowing);
+BENCHMARK(BM_RejectExpected);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief A monotonic bump allocator.
+ *
+ * Memory is carved out of large blocks and is never returned individually:
+ * deallocate() is a no-op and everything is released at once when the arena is
+ * reset or destroyed. Freeing a document therefore costs one free per block
+ * instead of one per node.
+ *
+ * The arena is a std::pmr::memory_resource, so it can also back pmr containers.
+ */
+class Arena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    explicit Arena(size_t initialBlockSize = DefaultBlockSize);
+    ~Arena() override;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Copies a string into the arena.
+     *
+     * @return A pointer to the copy, which is not null-terminated.
+     */
+    const char* copy(const char* data, size_t size);
+
+    /**
+     * @brief Frees every block.
+     */
+    void release();
+
+    /**
+     * @brief Discards everything allocated but keeps the memory for reuse.
+     *
+     * With a single block the arena just rewinds into it. With several, they
+     * are freed and the next allocation makes one block as large as all of
+     * them together, so an arena reset between similar documents stops
+     * allocating after the second one.
+     */
+    void reset();
+
+    /**
+     * @brief Number of bytes handed out since construction or the last release() or reset().
+     */
+    [[nodiscard]] size_t bytesUsed() const { return bytesUsed_; }
+
+private:
+    struct Block {
+        Block* next;
+        size_t size;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override;
+
+    void grow(size_t minimumSize);
+
+    Block* head_{};
+    char* cursor_{};
+    char* end_{};
+    size_t nextBlockSize_;
+    size_t bytesUsed_{};
+};
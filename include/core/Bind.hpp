@@ -0,0 +1,378 @@
+#pragma once
+
+#include <core/Number.hpp>
+#include <core/Sax.hpp>
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Describes one member of a struct that parse<T>() can fill.
+ */
+template<typename Class, typename Member>
+struct JsonField {
+    std::string_view name;
+    Member Class::* pointer;
+};
+
+/**
+ * @brief Pairs an enumerator with the string that represents it in JSON.
+ */
+template<typename Enum>
+struct JsonEnumValue {
+    std::string_view name;
+    Enum value;
+};
+
+// JSON_BIND_FOR_EACH(M, T, a, b, ...) expands to M(T, a), M(T, b), ... for up to 32 arguments.
+#define JSON_BIND_EXPAND(x) x
+#define JSON_BIND_FE_1(M, T, x) M(T, x)
+#define JSON_BIND_FE_2(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_1(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_3(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_2(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_4(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_3(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_5(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_4(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_6(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_5(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_7(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_6(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_8(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_7(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_9(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_8(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_10(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_9(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_11(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_10(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_12(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_11(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_13(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_12(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_14(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_13(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_15(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_14(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_16(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_15(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_17(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_16(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_18(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_17(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_19(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_18(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_20(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_19(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_21(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_20(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_22(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_21(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_23(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_22(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_24(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_23(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_25(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_24(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_26(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_25(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_27(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_26(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_28(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_27(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_29(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_28(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_30(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_29(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_31(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_30(M, T, __VA_ARGS__))
+#define JSON_BIND_FE_32(M, T, x, ...) M(T, x), JSON_BIND_EXPAND(JSON_BIND_FE_31(M, T, __VA_ARGS__))
+#define JSON_BIND_SELECT(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+#define JSON_BIND_FOR_EACH(M, T, ...) \
+    JSON_BIND_EXPAND(JSON_BIND_SELECT(__VA_ARGS__, JSON_BIND_FE_32, JSON_BIND_FE_31, JSON_BIND_FE_30, JSON_BIND_FE_29, JSON_BIND_FE_28, JSON_BIND_FE_27, JSON_BIND_FE_26, JSON_BIND_FE_25, JSON_BIND_FE_24, JSON_BIND_FE_23, JSON_BIND_FE_22, JSON_BIND_FE_21, JSON_BIND_FE_20, JSON_BIND_FE_19, JSON_BIND_FE_18, JSON_BIND_FE_17, JSON_BIND_FE_16, JSON_BIND_FE_15, JSON_BIND_FE_14, JSON_BIND_FE_13, JSON_BIND_FE_12, JSON_BIND_FE_11, JSON_BIND_FE_10, JSON_BIND_FE_9, JSON_BIND_FE_8, JSON_BIND_FE_7, JSON_BIND_FE_6, JSON_BIND_FE_5, JSON_BIND_FE_4, JSON_BIND_FE_3, JSON_BIND_FE_2, JSON_BIND_FE_1)(M, T, __VA_ARGS__))
+
+#define JSON_BIND_FIELD(Type, member) JsonField{#member, &Type::member}
+#define JSON_BIND_ENUM_VALUE(Type, value) JsonEnumValue<Type>{#value, Type::value}
+
+/**
+ * @brief Registers the members of a struct for parse<T>(), using the member
+ * names as JSON keys.
+ *
+ *     struct Point { double x; double y; };
+ *     JSON_FIELDS(Point, x, y)
+ *
+ * Place it in the namespace of the struct, after its definition. It defines
+ * jsonFields(std::type_identity<Type>), which may also be written by hand to
+ * use keys that differ from the member names. Up to 32 members are supported.
+ */
+#define JSON_FIELDS(Type, ...)                                                      \
+    constexpr auto jsonFields(std::type_identity<Type>) {                           \
+        return std::make_tuple(JSON_BIND_FOR_EACH(JSON_BIND_FIELD, Type, __VA_ARGS__)); \
+    }
+
+/**
+ * @brief Registers the enumerators of an enum, which are then read from their
+ * names. Enums that are not registered are read from their integer value.
+ */
+#define JSON_ENUM(Type, ...)                                                        \
+    constexpr auto jsonEnumValues(std::type_identity<Type>) {                       \
+        return std::array{JSON_BIND_FOR_EACH(JSON_BIND_ENUM_VALUE, Type, __VA_ARGS__)}; \
+    }
+
+template<typename T>
+concept JsonBindable = std::is_class_v<T> && requires { jsonFields(std::type_identity<T>{}); };
+
+template<typename T>
+concept JsonNamedEnum = std::is_enum_v<T> && requires { jsonEnumValues(std::type_identity<T>{}); };
+
+template<typename T>
+concept JsonOptional = requires { typename T::value_type; } && std::is_same_v<T, std::optional<typename T::value_type> >;
+
+template<typename T>
+concept JsonVector = requires { typename T::value_type; } && std::is_same_v<T, std::vector<typename T::value_type> >;
+
+/**
+ * @brief FNV-1a with a seed, usable at compile time.
+ */
+constexpr uint32_t jsonKeyHash(const std::string_view key, const uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (const char c: key) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief A perfect hash table over a fixed set of keys, built at compile time.
+ *
+ * The constructor searches for a seed under which every key lands in its own
+ * slot, so a lookup is one hash, one slot read and one string comparison.
+ */
+template<size_t N>
+class JsonKeyTable {
+public:
+    static constexpr size_t Slots = std::bit_ceil(N * 4);
+
+    constexpr explicit JsonKeyTable(const std::array<std::string_view, N>& names) : names_(names) {
+        for (uint32_t seed = 0; seed < (1u << 16); ++seed) {
+            if (tryBuild(seed)) {
+                seed_ = seed;
+                return;
+            }
+        }
+        throw std::logic_error("No perfect hash for these keys; are two fields named the same?");
+    }
+
+    /**
+     * @return The index of the key, or -1 if it is not one of the keys.
+     */
+    [[nodiscard]] constexpr int find(const std::string_view key) const {
+        const uint16_t slot = slots_[jsonKeyHash(key, seed_) & (Slots - 1)];
+        return slot != 0 && names_[slot - 1] == key ? slot - 1 : -1;
+    }
+
+private:
+    constexpr bool tryBuild(const uint32_t seed) {
+        slots_ = {};
+        for (size_t i = 0; i < N; ++i) {
+            uint16_t& slot = slots_[jsonKeyHash(names_[i], seed) & (Slots - 1)];
+            if (slot != 0) {
+                return false;
+            }
+            slot = static_cast<uint16_t>(i + 1);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> names_;
+    std::array<uint16_t, Slots> slots_{}; ///< Key index plus one; zero marks an empty slot.
+    uint32_t seed_{};
+};
+
+/**
+ * @brief Compile-time facts about a registered struct.
+ */
+template<JsonBindable T>
+struct JsonBinding {
+    static constexpr auto fields = jsonFields(std::type_identity<T>{});
+    static constexpr size_t count = std::tuple_size_v<std::remove_const_t<decltype(fields)> >;
+
+    static constexpr std::array<std::string_view, count> names = std::apply(
+        [](const auto&... field) { return std::array<std::string_view, count>{field.name...}; }, fields);
+
+    static constexpr JsonKeyTable<count> keys{names};
+
+    static constexpr std::array<bool, count> required = std::apply(
+        [](const auto&... field) {
+            return std::array<bool, count>{!JsonOptional<std::remove_cvref_t<decltype(std::declval<T&>().*field.pointer)> >...};
+        },
+        fields);
+};
+
+/**
+ * @brief Throws for a token that cannot be read as the value expected there.
+ */
+[[noreturn]] inline void throwBindError(const ParseErrorCode code, const Token& token) {
+    throw ParseException(
+        ParseError{token.type == TokenType::End ? ParseErrorCode::UnexpectedEnd : code, 0, 0, token.offset});
+}
+
+template<typename T>
+void readJson(TokenStream& tokens, T& out);
+
+/**
+ * @brief Consumes one value of any type, checking its syntax.
+ */
+inline void skipJson(TokenStream& tokens) {
+    NullHandler handler;
+    parseEvents(tokens, handler);
+}
+
+template<typename T, size_t... I>
+void readJsonField(TokenStream& tokens, T& out, const int index, std::index_sequence<I...>) {
+    (void) ((index == static_cast<int>(I) ? (readJson(tokens, out.*std::get<I>(JsonBinding<T>::fields).pointer), true) : false) || ...);
+}
+
+template<JsonBindable T>
+void readJsonObject(TokenStream& tokens, T& out) {
+    using Binding = JsonBinding<T>;
+
+    tokens.expect(TokenType::LeftBrace);
+    std::array<bool, Binding::count> seen{};
+    // Only an empty object may close straight away: after a comma, as in
+    // SaxReader, another member is required.
+    bool more = tokens.peek().type != TokenType::RightBrace;
+    while (more) {
+        const Token key = tokens.advance();
+        if (key.type != TokenType::String) {
+            throwBindError(ParseErrorCode::ExpectedKey, key);
+        }
+        tokens.expect(TokenType::Colon);
+
+        if (const int index = Binding::keys.find(key.value); index >= 0) {
+            readJsonField(tokens, out, index, std::make_index_sequence<Binding::count>{});
+            seen[static_cast<size_t>(index)] = true;
+        } else {
+            skipJson(tokens);
+        }
+
+        more = tokens.peek().type == TokenType::Comma;
+        if (more) {
+            tokens.advance();
+        }
+    }
+    tokens.expect(TokenType::RightBrace);
+
+    for (size_t i = 0; i < Binding::count; ++i) {
+        if (Binding::required[i] && !seen[i]) {
+            throw std::runtime_error("Missing field: " + std::string(Binding::names[i]));
+        }
+    }
+}
+
+template<typename T>
+void readJsonInteger(TokenStream& tokens, T& out) {
+    const Token token = tokens.advance();
+    if (token.type != TokenType::Number) {
+        throwBindError(ParseErrorCode::UnexpectedToken, token);
+    }
+    const char* end = token.value.data() + token.value.size();
+    if (const auto [ptr, ec] = std::from_chars(token.value.data(), end, out); ec != std::errc{} || ptr != end) {
+        throwBindError(ec == std::errc::result_out_of_range ? ParseErrorCode::NumberOutOfRange
+                                                            : ParseErrorCode::UnexpectedToken, token);
+    }
+}
+
+/**
+ * @brief Reads one value into out, consuming its tokens.
+ *
+ * Supported types are bool, arithmetic types, std::string, enums,
+ * std::optional (null or missing is nullopt), std::vector, and structs
+ * registered with JSON_FIELDS. Unknown object keys are skipped; a missing
+ * member is an error unless it is optional.
+ *
+ * @throws ParseException, with an offset, on malformed input or a value of
+ * the wrong type, and std::runtime_error for a missing member or an unknown
+ * enum name.
+ */
+template<typename T>
+void readJson(TokenStream& tokens, T& out) {
+    if constexpr (JsonBindable<T>) {
+        readJsonObject(tokens, out);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        const Token token = tokens.advance();
+        if (token.type != TokenType::Boolean) {
+            throwBindError(ParseErrorCode::UnexpectedToken, token);
+        }
+        out = token.value == "true";
+    } else if constexpr (std::is_integral_v<T>) {
+        readJsonInteger(tokens, out);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        const Token token = tokens.advance();
+        if (token.type != TokenType::Number) {
+            throwBindError(ParseErrorCode::UnexpectedToken, token);
+        }
+        out = std::visit([](const auto number) { return static_cast<T>(number); }, parseJsonNumber(token.value));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        const Token token = tokens.advance();
+        if (token.type != TokenType::String) {
+            throwBindError(ParseErrorCode::UnexpectedToken, token);
+        }
+        out.assign(token.value);
+    } else if constexpr (JsonNamedEnum<T>) {
+        const Token token = tokens.advance();
+        if (token.type != TokenType::String) {
+            throwBindError(ParseErrorCode::UnexpectedToken, token);
+        }
+        for (const auto& [name, value]: jsonEnumValues(std::type_identity<T>{})) {
+            if (name == token.value) {
+                out = value;
+                return;
+            }
+        }
+        throw std::runtime_error("Unknown enum value: " + std::string(token.value));
+    } else if constexpr (std::is_enum_v<T>) {
+        std::underlying_type_t<T> value{};
+        readJsonInteger(tokens, value);
+        out = static_cast<T>(value);
+    } else if constexpr (JsonOptional<T>) {
+        if (tokens.peek().type == TokenType::Null) {
+            tokens.advance();
+            out.reset();
+        } else {
+            readJson(tokens, out.emplace());
+        }
+    } else if constexpr (JsonVector<T>) {
+        out.clear();
+        tokens.expect(TokenType::LeftBracket);
+        bool more = tokens.peek().type != TokenType::RightBracket;
+        while (more) {
+            readJson(tokens, out.emplace_back());
+            more = tokens.peek().type == TokenType::Comma;
+            if (more) {
+                tokens.advance();
+            }
+        }
+        tokens.expect(TokenType::RightBracket);
+    } else {
+        static_assert(sizeof(T) == 0, "Type is not supported by readJson; register it with JSON_FIELDS");
+    }
+}
+
+/**
+ * @brief Parses JSON text straight into an existing value, without building a DOM.
+ *
+ * @throws ParseException, with line and column, on malformed input, a type
+ * mismatch or trailing content, and std::runtime_error for a missing member
+ * or an unknown enum name.
+ */
+template<typename T>
+void parseInto(const std::string_view json, T& out) {
+    Tokenizer tokenizer(json);
+    try {
+        TokenStream tokens(tokenizer);
+        readJson(tokens, out);
+        if (const Token& rest = tokens.peek(); rest.type != TokenType::End) {
+            throw ParseException(ParseError{ParseErrorCode::TrailingContent, 0, 0, rest.offset});
+        }
+    } catch (const ParseException& e) {
+        // Errors from the token stream only carry an offset.
+        ParseError error = e.error();
+        throw ParseException(error.locate(json));
+    }
+}
+
+/**
+ * @brief Parses JSON text straight into a T, without building a DOM.
+ *
+ * @throws ParseException, with line and column, on malformed input, a type
+ * mismatch or trailing content, and std::runtime_error for a missing member
+ * or an unknown enum name.
+ */
+template<typename T>
+T parse(const std::string_view json) {
+    T value{};
+    parseInto(json, value);
+    return value;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <core/Parser.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Encodes a value as CBOR (RFC 8949).
+ *
+ * Containers use definite lengths, integers the shortest head that holds
+ * them and doubles single precision when that is exact, so the encoding is
+ * usually well below the size of the JSON text. Integers keep their
+ * int64_t or uint64_t value exactly.
+ *
+ * @return The encoded bytes.
+ */
+std::string encodeCbor(const JsonValue& value);
+
+/**
+ * @brief Appends the CBOR encoding of a value to a buffer.
+ */
+void encodeCbor(const JsonValue& value, std::string& out);
+
+/**
+ * @brief Decodes one CBOR data item into a JsonValue tree.
+ *
+ * Every length is known from the item heads, so nothing is scanned for
+ * delimiters: containers are reserved up front and strings are copied in one
+ * piece after a UTF-8 check. Indefinite-length strings, arrays and maps are
+ * accepted, tags are ignored, and half, single and double precision floats
+ * all decode to double. Only items JSON can represent are supported: map
+ * keys must be text strings, and byte strings and undefined are rejected.
+ *
+ * @throws std::runtime_error naming the offset if the data is malformed,
+ * unsupported, nested deeper than SaxReader::MaxDepth or followed by more
+ * bytes.
+ */
+std::shared_ptr<JsonValue> decodeCbor(std::string_view bytes);
+
+/**
+ * @brief Encodes a value into a file, replacing it.
+ *
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void writeCborFile(const std::string& path, const JsonValue& value);
+
+/**
+ * @brief Decodes a file written by writeCborFile(), memory-mapping it.
+ *
+ * @throws std::runtime_error if the file cannot be read or is malformed.
+ */
+std::shared_ptr<JsonValue> readCborFile(const std::string& path);
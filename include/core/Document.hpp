@@ -0,0 +1,244 @@
+#pragma once
+
+#include <core/Arena.hpp>
+#include <core/KeyInterner.hpp>
+#include <core/Parser.hpp>
+
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string_view>
+
+enum class DomType : uint8_t {
+    Object,
+    Array,
+    String,
+    Number,
+    Boolean,
+    Null
+};
+
+/**
+ * @brief How a DomType::Number node stores its value.
+ */
+enum class NumberType : uint8_t {
+    Double,
+    Int64,
+    UInt64
+};
+
+struct DomMember;
+
+/**
+ * @brief A node of an arena-allocated Document.
+ *
+ * Nodes are plain data: containers point at a contiguous run of children in
+ * the same arena, strings point at arena-owned bytes. Nothing is reference
+ * counted and nothing needs a destructor.
+ */
+struct DomNode {
+    DomType type{DomType::Null};
+    NumberType numberType{NumberType::Double};
+    size_t size{}; ///< String length, element count or member count.
+    union {
+        double number{};
+        int64_t integer;
+        uint64_t unsignedInteger;
+        bool boolean;
+        const char* string;
+        const DomNode* elements;
+        const DomMember* members;
+    };
+};
+
+/**
+ * @brief A member of an object. Its key is interned in the owning Document.
+ */
+struct DomMember {
+    const InternedKey* name;
+    DomNode value;
+
+    [[nodiscard]] std::string_view key() const { return name->view(); }
+};
+
+/**
+ * @brief A non-owning handle to a value inside a Document.
+ *
+ * A default-constructed ValueRef refers to nothing and converts to false; it
+ * is what find() returns for a missing key. Handles are only valid while the
+ * Document they came from is alive.
+ */
+class ValueRef {
+public:
+    ValueRef() = default;
+    ValueRef(const DomNode& node) : node_(&node) {
+    }
+
+    explicit operator bool() const { return node_ != nullptr; }
+
+    [[nodiscard]] DomType type() const;
+    [[nodiscard]] bool isObject() const { return type() == DomType::Object; }
+    [[nodiscard]] bool isArray() const { return type() == DomType::Array; }
+    [[nodiscard]] bool isString() const { return type() == DomType::String; }
+    [[nodiscard]] bool isNumber() const { return type() == DomType::Number; }
+    [[nodiscard]] bool isBoolean() const { return type() == DomType::Boolean; }
+    [[nodiscard]] bool isNull() const { return type() == DomType::Null; }
+
+    [[nodiscard]] std::string_view asString() const;
+
+    /**
+     * @brief The value of any number, converted to double if it is integral.
+     */
+    [[nodiscard]] double asNumber() const;
+
+    /**
+     * @throws std::runtime_error if the number is not an integer that fits.
+     */
+    [[nodiscard]] int64_t asInt64() const;
+
+    /**
+     * @throws std::runtime_error if the number is not a non-negative integer.
+     */
+    [[nodiscard]] uint64_t asUInt64() const;
+
+    [[nodiscard]] NumberType numberType() const;
+    [[nodiscard]] bool asBoolean() const;
+
+    /**
+     * @brief Number of elements of an array or members of an object.
+     */
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] std::span<const DomNode> elements() const;
+    [[nodiscard]] std::span<const DomMember> members() const;
+
+    /**
+     * @throws std::runtime_error if this is not an array or the index is out of range.
+     */
+    ValueRef operator[](size_t index) const;
+
+    /**
+     * @throws std::runtime_error if this is not an object or the key is missing.
+     */
+    ValueRef operator[](std::string_view key) const;
+
+    /**
+     * @brief Looks up a key in an object.
+     *
+     * @return The value, or an empty ValueRef if the key is missing.
+     */
+    [[nodiscard]] ValueRef find(std::string_view key) const;
+
+    /**
+     * @brief Looks up a key obtained from Document::key(), comparing pointers only.
+     *
+     * @return The value, or an empty ValueRef if the key is missing.
+     */
+    [[nodiscard]] ValueRef find(const InternedKey* key) const;
+
+private:
+    [[nodiscard]] const DomNode& node(DomType expected) const;
+
+    const DomNode* node_{};
+};
+
+/**
+ * @brief A parsed JSON document whose nodes and strings all live in one Arena.
+ *
+ * Building a document performs a handful of block allocations in total and
+ * destroying it frees those blocks without visiting the nodes. Members of an
+ * object keep their document order.
+ *
+ * Object keys are interned: each distinct key is stored once per document
+ * and members point at it. Parsing with a shared KeyInterner additionally
+ * makes members reuse its keys, so repeated schemas cost no key memory.
+ */
+class Document {
+public:
+    /**
+     * @brief Parses JSON text. The input may be discarded afterwards.
+     *
+     * @throws ParseException on malformed input.
+     */
+    static Document parse(std::string_view json);
+
+    /**
+     * @brief Parses JSON text without throwing.
+     *
+     * Malformed input, including anything but whitespace after the value, is
+     * reported as a ParseError with its line and column; no exception is
+     * thrown or caught on that path. Running out of memory is reported as
+     * ParseErrorCode::OutOfMemory.
+     */
+    static std::expected<Document, ParseError> tryParse(std::string_view json) noexcept;
+
+    /**
+     * @brief As tryParse(json), taking object keys from a shared pool where possible.
+     */
+    static std::expected<Document, ParseError> tryParse(std::string_view json, const KeyInterner& sharedKeys) noexcept;
+
+    /**
+     * @brief Parses JSON text, taking object keys from a shared pool where possible.
+     *
+     * Keys missing from the pool are interned in the document itself; the pool
+     * is only read, so one pool can serve documents parsed on many threads.
+     * It must outlive the returned document.
+     *
+     * @throws ParseException on malformed input.
+     */
+    static Document parse(std::string_view json, const KeyInterner& sharedKeys);
+
+    /**
+     * @brief Parses a file by memory-mapping it.
+     *
+     * @throws std::runtime_error if the file cannot be read or is malformed.
+     */
+    static Document parseFile(const std::string& path);
+
+    /**
+     * @brief Copies a shared_ptr based JsonValue tree into a new Document.
+     */
+    static Document fromJsonValue(const JsonValue& value);
+
+    [[nodiscard]] ValueRef root() const { return *root_; }
+
+    /**
+     * @brief The interned form of a key, for use with ValueRef::find(const InternedKey*).
+     *
+     * @return The key, or nullptr if no object in the document has it.
+     */
+    [[nodiscard]] const InternedKey* key(std::string_view key) const;
+
+    /**
+     * @brief Distinct keys stored by this document, excluding those taken from a shared pool.
+     */
+    [[nodiscard]] size_t keyCount() const { return keys_->size(); }
+
+    /**
+     * @brief Converts the document to a shared_ptr based JsonValue tree, for
+     * code that has not migrated to ValueRef yet.
+     */
+    [[nodiscard]] std::shared_ptr<JsonValue> toJsonValue() const;
+
+    /**
+     * @brief Bytes of arena memory used by nodes and strings.
+     */
+    [[nodiscard]] size_t memoryUsage() const { return arena_->bytesUsed(); }
+
+private:
+    Document();
+
+    static Document parse(std::string_view json, const KeyInterner* sharedKeys);
+    static std::expected<Document, ParseError> tryParse(std::string_view json, const KeyInterner* sharedKeys) noexcept;
+
+    std::unique_ptr<Arena> arena_;
+    std::unique_ptr<KeyInterner> keys_;
+    const KeyInterner* sharedKeys_{};
+    const DomNode* root_{};
+};
+
+/**
+ * @brief Converts a value of a Document to a shared_ptr based JsonValue tree.
+ */
+std::shared_ptr<JsonValue> toJsonValue(ValueRef value);
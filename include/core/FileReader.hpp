@@ -7,9 +7,12 @@
  * @brief A class for reading files.
  * 
  * This class provides a static method to read the contents of a file
- * given its file path. The contents are returned as a string.
+ * given its file path. The contents are returned as a string, read with a
+ * single call into a buffer sized up front. Use MappedFile to parse a file
+ * without copying it at all.
  */
 class FileReader {
+public:
     /**
      * @brief Reads the contents of a file.
      * 
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief An insertion-ordered map from string keys to values, stored as one
+ * contiguous vector of pairs.
+ *
+ * Small objects, which are most of them, are searched linearly: a handful of
+ * string comparisons is cheaper than hashing, and there is no bucket array or
+ * per-entry node to allocate. Once an object grows past LinearSearchLimit
+ * members a compact open-addressing index of (position, hash) slots is built
+ * and kept up to date by further insertions, so large objects still get
+ * constant-time lookups.
+ *
+ * The interface follows std::unordered_map closely enough that code using
+ * find(), at(), emplace() and range-for works with either. Unlike
+ * unordered_map, iteration visits members in the order they were inserted,
+ * which keeps serialized output in document order. Keys must not be changed
+ * through an iterator. Const members never modify the object, so a finished
+ * object may be read from several threads.
+ */
+template<typename T>
+class FlatObject {
+public:
+    using key_type = std::string;
+    using mapped_type = T;
+    using value_type = std::pair<std::string, T>;
+    using size_type = size_t;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    static constexpr size_t LinearSearchLimit = 8;
+
+    FlatObject() = default;
+
+    FlatObject(const std::initializer_list<value_type> members) {
+        reserve(members.size());
+        for (const value_type& member: members) {
+            emplace(member.first, member.second);
+        }
+    }
+
+    [[nodiscard]] iterator begin() { return entries_.begin(); }
+    [[nodiscard]] iterator end() { return entries_.end(); }
+    [[nodiscard]] const_iterator begin() const { return entries_.begin(); }
+    [[nodiscard]] const_iterator end() const { return entries_.end(); }
+    [[nodiscard]] const_iterator cbegin() const { return entries_.cbegin(); }
+    [[nodiscard]] const_iterator cend() const { return entries_.cend(); }
+
+    [[nodiscard]] size_t size() const { return entries_.size(); }
+    [[nodiscard]] bool empty() const { return entries_.empty(); }
+
+    void reserve(const size_t count) { entries_.reserve(count); }
+
+    void clear() {
+        entries_.clear();
+        index_.clear();
+    }
+
+    [[nodiscard]] iterator find(const std::string_view key) {
+        return entries_.begin() + static_cast<std::ptrdiff_t>(position(key));
+    }
+
+    [[nodiscard]] const_iterator find(const std::string_view key) const {
+        return entries_.begin() + static_cast<std::ptrdiff_t>(position(key));
+    }
+
+    [[nodiscard]] bool contains(const std::string_view key) const { return position(key) != entries_.size(); }
+    [[nodiscard]] size_t count(const std::string_view key) const { return contains(key) ? 1 : 0; }
+
+    /**
+     * @throws std::out_of_range if the key is missing.
+     */
+    T& at(const std::string_view key) {
+        return const_cast<T&>(std::as_const(*this).at(key));
+    }
+
+    const T& at(const std::string_view key) const {
+        const size_t found = position(key);
+        if (found == entries_.size()) {
+            throw std::out_of_range("FlatObject::at: key not found: " + std::string(key));
+        }
+        return entries_[found].second;
+    }
+
+    T& operator[](const std::string_view key) {
+        return try_emplace(key).first->second;
+    }
+
+    /**
+     * @brief Appends a member unless the key is already present.
+     *
+     * @return The member with that key and whether it was inserted.
+     */
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> emplace(K&& key, Args&&... args) {
+        return insert(std::string(std::forward<K>(key)), [&] { return T(std::forward<Args>(args)...); });
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const std::string_view key, Args&&... args) {
+        return insert(std::string(key), [&] { return T(std::forward<Args>(args)...); });
+    }
+
+    template<typename V>
+    std::pair<iterator, bool> insert_or_assign(const std::string_view key, V&& value) {
+        auto result = try_emplace(key);
+        result.first->second = std::forward<V>(value);
+        return result;
+    }
+
+    /**
+     * @brief Removes a member, keeping the order of the others.
+     *
+     * @return The number of members removed.
+     */
+    size_t erase(const std::string_view key) {
+        const size_t found = position(key);
+        if (found == entries_.size()) {
+            return 0;
+        }
+        entries_.erase(entries_.begin() + static_cast<std::ptrdiff_t>(found));
+        rebuildIndex();
+        return 1;
+    }
+
+    /**
+     * @brief Members are equal in any order, as for unordered_map.
+     */
+    friend bool operator==(const FlatObject& lhs, const FlatObject& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        for (const auto& [key, value]: lhs) {
+            const auto other = rhs.find(key);
+            if (other == rhs.end() || !(other->second == value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Slot {
+        uint32_t position; ///< Entry position plus one; zero marks an empty slot.
+        uint32_t hash;
+    };
+
+    static uint32_t hash(const std::string_view key) {
+        return static_cast<uint32_t>(std::hash<std::string_view>{}(key));
+    }
+
+    /**
+     * Returns the position of the key, or size() if it is missing.
+     */
+    [[nodiscard]] size_t position(const std::string_view key) const {
+        if (index_.empty()) {
+            for (size_t i = 0; i < entries_.size(); ++i) {
+                if (entries_[i].first == key) {
+                    return i;
+                }
+            }
+            return entries_.size();
+        }
+
+        const uint32_t keyHash = hash(key);
+        const size_t mask = index_.size() - 1;
+        for (size_t slot = keyHash & mask; index_[slot].position != 0; slot = (slot + 1) & mask) {
+            if (index_[slot].hash == keyHash && entries_[index_[slot].position - 1].first == key) {
+                return index_[slot].position - 1;
+            }
+        }
+        return entries_.size();
+    }
+
+    template<typename Make>
+    std::pair<iterator, bool> insert(std::string key, Make&& make) {
+        if (const size_t found = position(key); found != entries_.size()) {
+            return {entries_.begin() + static_cast<std::ptrdiff_t>(found), false};
+        }
+
+        const uint32_t keyHash = index_.empty() ? 0 : hash(key);
+        entries_.emplace_back(std::move(key), make());
+
+        if (!index_.empty() && entries_.size() * 2 <= index_.size()) {
+            place(static_cast<uint32_t>(entries_.size()), keyHash);
+        } else if (entries_.size() > LinearSearchLimit) {
+            rebuildIndex();
+        }
+        return {entries_.end() - 1, true};
+    }
+
+    void place(const uint32_t position, const uint32_t keyHash) {
+        const size_t mask = index_.size() - 1;
+        size_t slot = keyHash & mask;
+        while (index_[slot].position != 0) {
+            slot = (slot + 1) & mask;
+        }
+        index_[slot] = Slot{position, keyHash};
+    }
+
+    void rebuildIndex() {
+        index_.clear();
+        if (entries_.size() <= LinearSearchLimit) {
+            return;
+        }
+        size_t slots = 16;
+        while (slots < entries_.size() * 2) {
+            slots *= 2;
+        }
+        index_.assign(slots, Slot{0, 0});
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            place(static_cast<uint32_t>(i + 1), hash(entries_[i].first));
+        }
+    }
+
+    std::vector<value_type> entries_;
+    std::vector<Slot> index_;
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <core/Parser.hpp>
+#include <core/Tokenizer.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief A JSONPath query, compiled once and run against many documents.
+ *
+ * The supported subset:
+ * - `$`, the root, which every path starts with;
+ * - child members `.name`, `['name']` and `["name"]`;
+ * - wildcards `.*` and `[*]`;
+ * - array indices `[2]` and slices `[start:end:step]`;
+ * - unions of the above, as in `[0, 2]` or `['a', 'b']`;
+ * - recursive descent `..name`, `..*` and `..[selectors]`;
+ * - filters `[?(@.price < 10 && @.tags[0] == 'sale')]`, comparing values
+ *   below the candidate (`@`, `@.a.b`, `@['a'][0]`) with each other or with
+ *   numbers, strings, true, false and null; `@.isbn` alone tests existence.
+ *
+ * Matching is done in one forward pass, so indices and slice bounds must not
+ * be negative. Inside filters, which see the whole candidate, they may be.
+ *
+ * Selecting from text runs the compiled path directly over the tokens as
+ * they are produced. Subtrees that no step of the path can reach are skipped
+ * without building anything. Only the matched values are materialized,
+ * together with the candidates of filter steps, which have to be built to
+ * test them.
+ */
+class JsonPath {
+public:
+    /**
+     * @throws std::runtime_error naming the offset if the expression is
+     * malformed or outside the supported subset.
+     */
+    static JsonPath compile(std::string_view expression);
+
+    /**
+     * @brief The values matched in a JSON document, in document order.
+     *
+     * @throws ParseException on malformed input, including anything but
+     * whitespace after the value.
+     */
+    [[nodiscard]] std::vector<std::shared_ptr<JsonValue> > select(std::string_view json) const;
+
+    /**
+     * @brief As select(std::string_view), over the tokens of a tokenizer
+     * that has not produced any yet. Its settings are kept, except that it
+     * records errors.
+     */
+    [[nodiscard]] std::vector<std::shared_ptr<JsonValue> > select(Tokenizer& tokenizer) const;
+
+    /**
+     * @brief The values matched in an already built tree.
+     *
+     * Matched values are shared with the tree rather than copied. They come
+     * in the order the tree is walked, which is document order only with
+     * JSON_FLAT_OBJECT; otherwise the members of each object are visited in
+     * the unspecified order of std::unordered_map.
+     */
+    [[nodiscard]] std::vector<std::shared_ptr<JsonValue> > select(const std::shared_ptr<JsonValue>& root) const;
+
+    [[nodiscard]] const std::string& expression() const { return expression_; }
+
+    /**
+     * @brief The most steps a path may have; matching keeps one bit per step.
+     */
+    static constexpr size_t MaxSteps = 63;
+
+private:
+    friend class JsonPathCompiler;
+    friend class JsonPathMatcher;
+
+    /**
+     * A set of positions in the path, one bit per step. Bit k means "steps
+     * before k have matched"; bit steps_.size() means the value is a match.
+     */
+    using States = uint64_t;
+
+    struct Slice {
+        size_t start{};
+        size_t end{SIZE_MAX};
+        size_t step{1};
+    };
+
+    /**
+     * A member or element to descend into, as used by filter queries.
+     */
+    struct QueryKey {
+        std::string name;
+        int64_t index{}; ///< Used when name is empty; negative counts from the end.
+        bool isIndex{};
+    };
+
+    using Literal = std::variant<std::nullptr_t, bool, double, std::string>;
+
+    struct FilterOperand {
+        bool isQuery{};
+        std::vector<QueryKey> query; ///< Relative to the candidate, if isQuery.
+        Literal literal;
+    };
+
+    enum class FilterOp : uint8_t {
+        Or,
+        And,
+        Not,
+        Exists,
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual
+    };
+
+    struct Filter {
+        FilterOp op{};
+        std::vector<Filter> children; ///< Operands of Or, And and Not.
+        FilterOperand left;
+        FilterOperand right;
+    };
+
+    struct Selector {
+        enum class Kind : uint8_t {
+            Name,
+            Wildcard,
+            Index,
+            Slice,
+            Filter
+        };
+
+        Kind kind{};
+        std::string name;
+        size_t index{};
+        Slice slice;
+        Filter filter;
+    };
+
+    struct Step {
+        bool descendant{}; ///< Applies to every descendant of the value, not just its children.
+        std::vector<Selector> selectors;
+    };
+
+    JsonPath() = default;
+
+    [[nodiscard]] States finalState() const { return States{1} << steps_.size(); }
+
+    /**
+     * States of a child given those of its parent, counting every selector
+     * but filters, which need the child itself.
+     */
+    [[nodiscard]] States childStates(States parent, std::string_view key, size_t index, bool inArray) const;
+
+    /**
+     * States a child gains from the filters that accept it.
+     */
+    [[nodiscard]] States filterStates(States parent, const JsonValue& child) const;
+
+    /**
+     * Whether a filter accepts a candidate.
+     */
+    [[nodiscard]] static bool test(const Filter& filter, const JsonValue& candidate);
+
+    void collect(const std::shared_ptr<JsonValue>& value, States states,
+                 std::vector<std::shared_ptr<JsonValue> >& results) const;
+
+    std::string expression_;
+    std::vector<Step> steps_;
+    States filterMask_{}; ///< States whose step has a filter selector.
+};
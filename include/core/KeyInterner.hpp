@@ -0,0 +1,84 @@
+#pragma once
+
+#include <core/Arena.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief An object key stored once per interner, together with its hash.
+ *
+ * Keys interned by the same KeyInterner are equal exactly when their
+ * pointers are equal.
+ */
+struct InternedKey {
+    const char* data;
+    size_t size;
+    size_t hash;
+    uint32_t id; ///< Dense index in insertion order, usable as an array subscript.
+
+    [[nodiscard]] std::string_view view() const { return {data, size}; }
+};
+
+/**
+ * @brief A string pool for object keys.
+ *
+ * Records with the same keys store each distinct key once, so key memory is
+ * proportional to the number of unique keys instead of the number of
+ * members. The hash of a key is computed when it is interned and reused by
+ * every lookup afterwards.
+ *
+ * An interner either allocates from an Arena it is given, tying the keys to
+ * that arena's lifetime (a Document does this), or owns its own arena. An
+ * owned interner can be filled with the keys of a known schema and then
+ * shared read-only between threads and documents: the const members are safe
+ * to call concurrently as long as nobody calls intern().
+ */
+class KeyInterner {
+public:
+    KeyInterner();
+    explicit KeyInterner(Arena& arena);
+
+    KeyInterner(const KeyInterner&) = delete;
+    KeyInterner& operator=(const KeyInterner&) = delete;
+
+    static size_t hash(std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+    /**
+     * @brief Returns the pooled copy of a key, adding it if it is new.
+     */
+    const InternedKey* intern(std::string_view key) { return intern(key, hash(key)); }
+
+    /**
+     * @brief As intern(key), with a hash already computed by KeyInterner::hash().
+     */
+    const InternedKey* intern(std::string_view key, size_t hash);
+
+    /**
+     * @brief Looks up a key without adding it.
+     *
+     * @return The pooled key, or nullptr if it was never interned.
+     */
+    [[nodiscard]] const InternedKey* find(std::string_view key) const { return find(key, hash(key)); }
+    [[nodiscard]] const InternedKey* find(std::string_view key, size_t hash) const;
+
+    /**
+     * @brief Number of distinct keys.
+     */
+    [[nodiscard]] size_t size() const { return keys_.size(); }
+
+    /**
+     * @brief The key with the given id.
+     */
+    [[nodiscard]] const InternedKey& operator[](const uint32_t id) const { return *keys_[id]; }
+
+private:
+    void rehash();
+
+    std::unique_ptr<Arena> ownedArena_;
+    Arena& arena_;
+    std::vector<const InternedKey*> slots_; ///< Open addressing, linear probing, power-of-two size.
+    std::vector<const InternedKey*> keys_;
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <core/MappedFile.hpp>
+#include <core/Number.hpp>
+#include <core/Parser.hpp>
+#include <core/StructuralIndex.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class LazyDocument;
+
+/**
+ * @brief A value of a LazyDocument that has not been parsed yet.
+ *
+ * A LazyValue is a position in the document. Lookups walk the structural
+ * index, skipping every sibling subtree by jumping to its matching bracket,
+ * and values are only converted when an accessor asks for them. A
+ * default-constructed LazyValue refers to nothing and converts to false.
+ */
+class LazyValue {
+public:
+    enum class Type {
+        Object,
+        Array,
+        String,
+        Number,
+        Boolean,
+        Null
+    };
+
+    LazyValue() = default;
+
+    explicit operator bool() const { return document_ != nullptr; }
+
+    [[nodiscard]] Type type() const;
+
+    /**
+     * @brief Looks up a member of an object.
+     *
+     * @return The value, or an empty LazyValue if this is not an object or the key is missing.
+     */
+    [[nodiscard]] LazyValue find(std::string_view key) const;
+
+    /**
+     * @brief Looks up an element of an array.
+     *
+     * @return The value, or an empty LazyValue if this is not an array or the index is out of range.
+     */
+    [[nodiscard]] LazyValue find(size_t index) const;
+
+    /**
+     * @throws std::runtime_error if the key is missing.
+     */
+    LazyValue operator[](std::string_view key) const;
+
+    /**
+     * @throws std::runtime_error if the index is out of range.
+     */
+    LazyValue operator[](size_t index) const;
+
+    /**
+     * @brief Number of members of an object or elements of an array. Walks the container.
+     */
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] std::string asString() const;
+    [[nodiscard]] JsonNumber asNumber() const;
+    [[nodiscard]] bool asBoolean() const;
+
+    /**
+     * @brief Parses this value and everything below it into a JsonValue tree.
+     *
+     * @throws std::runtime_error if the value is malformed.
+     */
+    [[nodiscard]] std::shared_ptr<JsonValue> materialize() const;
+
+    /**
+     * @brief Raw JSON text of this value.
+     */
+    [[nodiscard]] std::string_view text() const;
+
+private:
+    friend class LazyDocument;
+
+    LazyValue(const LazyDocument* document, const size_t entry) : document_(document), entry_(entry) {
+    }
+
+    [[nodiscard]] char head() const;
+    [[nodiscard]] size_t nextSibling(size_t entry) const;
+    [[nodiscard]] Token token() const;
+
+    const LazyDocument* document_{};
+    size_t entry_{};
+};
+
+/**
+ * @brief A document that is indexed up front and parsed on demand.
+ *
+ * Construction only runs the vectorized StructuralIndex and pairs every
+ * bracket with its match. Values are parsed when they are reached through
+ * at() with an RFC 6901 JSON Pointer, or through chained lookups on root().
+ * This suits reading a few fields out of large documents.
+ *
+ * Only the structure the lookups walk through is checked; malformed parts of
+ * untouched subtrees are not reported. Keys are matched after decoding
+ * their escape sequences, and strings are decoded when read, so "caf\u00e9"
+ * and "café" are the same key.
+ *
+ * The input buffer must outlive the document, unless the document was opened
+ * with fromFile(), which keeps the file mapped.
+ */
+class LazyDocument {
+public:
+    /**
+     * @throws std::runtime_error if brackets are unbalanced or a string is unterminated.
+     */
+    explicit LazyDocument(std::string_view json);
+
+    /**
+     * @brief Memory-maps a file and indexes it.
+     */
+    static LazyDocument fromFile(const std::string& path);
+
+    [[nodiscard]] LazyValue root() const;
+
+    /**
+     * @brief Resolves an RFC 6901 JSON Pointer such as "/user/roles/0".
+     *
+     * @throws std::runtime_error if the pointer is malformed or does not resolve.
+     */
+    [[nodiscard]] LazyValue at(std::string_view pointer) const;
+
+    /**
+     * @brief Resolves an RFC 6901 JSON Pointer.
+     *
+     * @return The value, or an empty LazyValue if the pointer does not resolve.
+     * @throws std::runtime_error if the pointer is malformed.
+     */
+    [[nodiscard]] LazyValue find(std::string_view pointer) const;
+
+private:
+    friend class LazyValue;
+
+    explicit LazyDocument(MappedFile file);
+
+    void matchBrackets();
+
+    std::optional<MappedFile> file_;
+    std::string_view input_;
+    StructuralIndex index_;
+    std::vector<size_t> match_; ///< For each bracket entry, the entry of its partner.
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Read-only view of a whole file's contents.
+ *
+ * Regular files are memory-mapped and advised for sequential access, so
+ * parsing straight out of view() never copies them. Where mapping is
+ * unavailable or fails, the contents are loaded with a single read into a
+ * buffer sized up front. Pipes and devices, whose size is not known, are read
+ * to end of file into a growing buffer.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Opens and maps a file.
+     *
+     * @param path The path to the file to be mapped.
+     * @throws std::runtime_error if the file cannot be opened or read, or is
+     * a directory.
+     */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] const char* data() const { return data_; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] std::string_view view() const { return {data_, size_}; }
+
+    /**
+     * @brief True if the contents are memory-mapped rather than read into a buffer.
+     */
+    [[nodiscard]] bool isMapped() const { return mapped_; }
+
+private:
+    void unmap();
+
+    const char* data_{};
+    size_t size_{};
+    bool mapped_{};
+    std::unique_ptr<char[]> buffer_;
+};
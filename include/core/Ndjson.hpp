@@ -0,0 +1,56 @@
+#pragma once
+
+#include <core/Parser.hpp>
+#include <core/WorkerPool.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct NdjsonOptions {
+    size_t threads = 0; ///< Worker threads; 0 uses std::thread::hardware_concurrency().
+    bool ordered = true; ///< Deliver records in input order rather than as soon as they are parsed.
+    size_t batchBytes = 1 << 20; ///< Approximate amount of input handed to a worker at a time.
+    WorkerPool* pool = nullptr; ///< Existing pool to run on instead of starting `threads` new workers.
+};
+
+/**
+ * @brief One line of newline-delimited JSON.
+ */
+struct NdjsonRecord {
+    size_t offset{}; ///< Byte offset of the line in the input.
+    std::shared_ptr<JsonValue> value; ///< The parsed value, or nullptr if the line is malformed.
+    std::string error; ///< Why the line is malformed, and at which column of it.
+};
+
+using NdjsonSink = std::function<void(NdjsonRecord&&)>;
+
+/**
+ * @brief Parses newline-delimited JSON (JSON Lines) on a pool of workers.
+ *
+ * The input is cut into batches at line boundaries and every batch is parsed
+ * by one worker with its own tokenizer and builder. Blank lines are skipped and
+ * a trailing '\r' is ignored. Records are handed to the sink on the calling
+ * thread, so the sink needs no synchronization. At most a few batches per
+ * worker are in flight, which bounds memory on large inputs.
+ *
+ * Malformed lines do not stop the parse; they are delivered with an error.
+ *
+ * @throws Whatever the sink throws, once in-flight batches have finished.
+ */
+void parseNdjson(std::string_view input, const NdjsonSink& sink, const NdjsonOptions& options = {});
+
+/**
+ * @brief Parses newline-delimited JSON into a vector of values in input order.
+ *
+ * @throws std::runtime_error naming the offset of the first malformed line.
+ */
+std::vector<std::shared_ptr<JsonValue>> parseNdjson(std::string_view input, const NdjsonOptions& options = {});
+
+/**
+ * @brief Memory-maps a newline-delimited JSON file and parses it with parseNdjson().
+ */
+void parseNdjsonFile(const std::string& path, const NdjsonSink& sink, const NdjsonOptions& options = {});
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+/**
+ * @brief A parsed JSON number.
+ *
+ * Integers that fit are kept exact as int64_t (or uint64_t above INT64_MAX);
+ * everything else, including integers too large for 64 bits, is a double.
+ */
+using JsonNumber = std::variant<int64_t, uint64_t, double>;
+
+/**
+ * @brief Length of the longest prefix of the input that can be part of a
+ * number: digits, signs, '.', 'e' and 'E'.
+ */
+size_t scanNumber(std::string_view input);
+
+/**
+ * @brief Checks text against the RFC 8259 number grammar:
+ * `-? (0 | [1-9][0-9]*) (.[0-9]+)? ([eE][+-]?[0-9]+)?`
+ */
+bool isJsonNumber(std::string_view text);
+
+/**
+ * @brief Converts JSON number text to its value.
+ *
+ * Parsing is locale-independent. Values too small for a double round to a
+ * signed zero.
+ *
+ * @param text Text accepted by isJsonNumber().
+ * @throws std::runtime_error if the number is too large for a double.
+ */
+JsonNumber parseJsonNumber(std::string_view text);
+
+/**
+ * @brief As parseJsonNumber(), but returns nullopt instead of throwing.
+ */
+std::optional<JsonNumber> tryParseJsonNumber(std::string_view text) noexcept;
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <core/Parser.hpp>
+#include <core/WorkerPool.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+struct ParallelArrayOptions {
+    size_t threads = 0; ///< Worker threads; 0 uses std::thread::hardware_concurrency().
+    size_t chunkBytes = 1 << 20; ///< Approximate amount of input handed to a worker at a time.
+    WorkerPool* pool = nullptr; ///< Existing pool to run on instead of starting `threads` new workers.
+};
+
+/**
+ * @brief Parses a document whose root is an array, splitting the elements
+ * between a pool of workers.
+ *
+ * A vectorized pre-scan that skips over strings finds the commas between the
+ * root array's elements. Runs of consecutive elements of about chunkBytes
+ * are then parsed by workers, each with its own tokenizer and builder, and
+ * the results are joined into one JsonArray in document order. The calling
+ * thread parses chunks too rather than block on the pool, so a task running
+ * on options.pool may call this with that same pool.
+ *
+ * Any other document, and any input smaller than one chunk, is parsed on the
+ * calling thread.
+ *
+ * @throws ParseException on malformed input, located in the whole document
+ * like Parser::parse() would; if several chunks are malformed, the first.
+ */
+std::shared_ptr<JsonValue> parseArrayParallel(std::string_view json, const ParallelArrayOptions& options = {});
+
+/**
+ * @brief Memory-maps a file and parses it with parseArrayParallel().
+ */
+std::shared_ptr<JsonValue> parseArrayParallelFile(const std::string& path, const ParallelArrayOptions& options = {});
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+enum class ParseErrorCode : uint8_t {
+    UnexpectedEnd,
+    UnexpectedToken,
+    ExpectedKey,
+    ExpectedColon,
+    ExpectedCommaOrEnd,
+    UnterminatedString,
+    InvalidNumber,
+    NumberOutOfRange,
+    InvalidKeyword,
+    InvalidCharacter,
+    TrailingContent,
+    OutOfMemory,
+    InvalidEscape,
+    ControlCharacter,
+    InvalidUtf8,
+    TooDeep
+};
+
+/**
+ * @brief A short, static description of an error code.
+ */
+const char* describe(ParseErrorCode code);
+
+/**
+ * @brief Where and why a parse failed.
+ *
+ * The struct is plain data and cheap to return; the human-readable message
+ * is only formatted when message() is called. Line and column are 1-based
+ * and count bytes; they are zero when the input was not available to
+ * locate() the offset.
+ */
+struct ParseError {
+    ParseErrorCode code{};
+    uint32_t line{};
+    uint32_t column{};
+    size_t offset{}; ///< Byte offset of the offending token in the input.
+
+    /**
+     * @brief Fills in line and column from the input the offset refers to.
+     */
+    ParseError& locate(std::string_view input);
+
+    [[nodiscard]] std::string message() const;
+};
+
+/**
+ * @brief The exception thrown by the throwing parse functions. It carries the
+ * same ParseError that the non-throwing functions return.
+ */
+class ParseException : public std::runtime_error {
+public:
+    explicit ParseException(const ParseError& error) : std::runtime_error(error.message()), error_(error) {
+    }
+
+    [[nodiscard]] const ParseError& error() const { return error_; }
+
+private:
+    ParseError error_;
+};
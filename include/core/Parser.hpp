@@ -1,20 +1,39 @@
 #pragma once
 
+#include <core/FlatObject.hpp>
+#include <core/MappedFile.hpp>
+#include <core/Sax.hpp>
 #include <core/Tokenizer.hpp>
-#include <core/Parser.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <variant>
 #include <unordered_map>
 
 class JsonValue;
 
+/**
+ * Objects keep their members in document order unless the build disables
+ * JSON_FLAT_OBJECT, in which case they are unordered.
+ */
+#ifdef JSON_FLAT_OBJECT
+using JsonObject = FlatObject<std::shared_ptr<JsonValue> >;
+#else
 using JsonObject = std::unordered_map<std::string, std::shared_ptr<JsonValue> >;
+#endif
 using JsonArray = std::vector<std::shared_ptr<JsonValue> >;
 
 class JsonValue {
 public:
-    using ValueType = std::variant<JsonObject, JsonArray, std::string, double, bool, std::nullptr_t>;
+    /**
+     * Integral numbers are stored exactly as int64_t, or as uint64_t when
+     * they exceed INT64_MAX; all other numbers are double.
+     */
+    using ValueType = std::variant<JsonObject, JsonArray, std::string, double, bool, std::nullptr_t, int64_t, uint64_t>;
 
     explicit JsonValue(ValueType v) : value_(std::move(v)) {
     }
@@ -24,35 +43,155 @@ private:
     ValueType value_;
 };
 
-class Parser {
+/**
+ * @brief A JsonHandler that builds a shared_ptr based JsonValue tree.
+ */
+class DomBuilder {
 public:
-    explicit Parser(std::vector<Token>& tokens);
-    explicit Parser(const std::string& inputOrFilePath, bool isFile = false);
-
-    std::shared_ptr<JsonValue> parse();
+    bool onStartObject();
+    bool onKey(std::string_view key);
+    bool onEndObject();
+    bool onStartArray();
+    bool onEndArray();
+    bool onString(std::string_view value);
+    bool onNumber(std::string_view text);
+    bool onBoolean(bool value);
+    bool onNull();
+
+    /**
+     * @brief Takes the completed value, or nullptr if none has completed.
+     */
+    std::shared_ptr<JsonValue> result() { return std::move(root_); }
+
+    /**
+     * @brief Where the number that stopped the build starts, or nullptr.
+     *
+     * Numbers outside the range of double make the builder stop the parse
+     * rather than throw, so that the parser can report where they are.
+     */
+    [[nodiscard]] const char* numberOutOfRange() const { return numberOutOfRange_; }
+
+    /**
+     * @brief The NumberOutOfRange error for that number, located in the input
+     * its text is a view of.
+     */
+    [[nodiscard]] ParseError numberError(std::string_view input) const;
+
+    /**
+     * @brief Drops any partly built value, e.g. after a failed parse, keeping
+     * the capacity of the internal stacks.
+     */
+    void reset();
 
 private:
-    std::shared_ptr<JsonValue> parseValue();
-
-    JsonObject parseObject();
-
-    JsonArray parseArray();
-
-    std::string parseString();
-
-    double parseNumber();
-
-    bool parseBoolean();
+    bool add(JsonValue::ValueType value);
 
-    std::nullptr_t parseNull();
+    std::vector<JsonValue::ValueType> stack_;
+    std::vector<std::string> keys_;
+    std::shared_ptr<JsonValue> root_;
+    const char* numberOutOfRange_{};
+};
 
-    [[nodiscard]] const Token &peek() const;
+/**
+ * A Parser can be reset() to a new document and reused. It keeps its input
+ * buffer, its tokenizer's decoded-string storage and its DomBuilder's stacks,
+ * so parsing many small documents with one parser stops allocating for
+ * anything but the values it builds. See ParserPool for per-thread reuse.
+ */
+class Parser {
+public:
+    /**
+     * @brief A parser with no document; give it one with reset().
+     */
+    Parser() = default;
+
+    /**
+     * @brief Parses an already tokenized document.
+     *
+     * The tokens are not copied: they, and the buffer they refer to, must
+     * outlive the parser. Given the text they were read from, errors are
+     * reported with line and column rather than just an offset.
+     */
+    explicit Parser(std::span<const Token> tokens, std::string_view text = {});
+
+    /**
+     * @brief Parses a JSON string or file.
+     *
+     * Tokens are pulled from a Tokenizer one at a time while parsing, so no
+     * token vector is ever built and token storage stays constant regardless
+     * of document size. Syntax errors are therefore reported by parse().
+     *
+     * Files are memory-mapped and tokenized in place without being copied.
+     */
+    explicit Parser(const std::string& inputOrFilePath, bool isFile = false);
 
-    const Token &advance();
+    Parser(const Parser&) = delete;
+    Parser& operator=(const Parser&) = delete;
+
+    /**
+     * @brief Switches to a new JSON string or file, as if constructed with
+     * the same arguments, reusing the buffers of earlier documents.
+     *
+     * Values already returned by parse() are unaffected.
+     *
+     * @throws std::runtime_error if the file cannot be mapped; the parser is
+     * then left with an empty document.
+     */
+    void reset(std::string_view inputOrFilePath, bool isFile = false);
+
+    /**
+     * @brief Switches to an already tokenized document, optionally with the
+     * text it was read from.
+     */
+    void reset(std::span<const Token> tokens, std::string_view text = {});
+
+    /**
+     * @brief Builds the document's JsonValue tree with a DomBuilder.
+     *
+     * Use parseEvents() with a custom JsonHandler to process a document
+     * without building a tree.
+     *
+     * @throws ParseException on malformed input or a number outside the
+     * range of double.
+     */
+    std::shared_ptr<JsonValue> parse();
 
-    void expect(TokenType type);
+    /**
+     * @brief Reports the document to a handler instead of building a tree.
+     *
+     * @return false if the handler stopped the parse early.
+     * @throws ParseException on malformed input, including anything but
+     * whitespace after the value.
+     */
+    template<JsonHandler Handler>
+    bool parse(Handler& handler);
 
 private:
-    Tokenizer::TokenVector tokens_;
-    size_t currentIndex_{};
+    [[noreturn]] void fail(ParseError error) const;
+    [[nodiscard]] size_t offsetOf(const char* text) const;
+
+    std::string input_;
+    std::optional<MappedFile> file_;
+    std::optional<Tokenizer> tokenizer_;
+    std::span<const Token> tokens_;
+    std::string_view text_; ///< The text of pre-tokenized input, if known.
+    DomBuilder builder_;
 };
+
+template<JsonHandler Handler>
+bool Parser::parse(Handler& handler) {
+    TokenStream tokens = tokenizer_ ? TokenStream(*tokenizer_) : TokenStream(tokens_, text_.size());
+    ParseError error;
+    SaxReader<Handler> reader(tokens, handler, error);
+
+    if (!reader.parseValue()) {
+        if (!reader.failed()) {
+            return false;
+        }
+        fail(error);
+    }
+    if (tokens.peek().type != TokenType::End) {
+        fail(ParseError{ParseErrorCode::TrailingContent, 0, 0, tokens.peek().offset});
+    }
+    return true;
+}
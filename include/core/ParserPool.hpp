@@ -0,0 +1,64 @@
+#pragma once
+
+#include <core/Parser.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+/**
+ * @brief Per-thread free lists of Parser objects.
+ *
+ * A thread that parses many documents through the pool keeps reusing the
+ * same few parsers and the buffers they have grown, so it settles at the
+ * allocations of the values it builds and nothing more. Parsers never move
+ * between threads, so acquiring and releasing takes no lock.
+ *
+ * acquire() hands out an idle parser of the calling thread, or a new one if
+ * they are all in use, e.g. by a parse further up the stack. A parser keeps
+ * buffers sized for the largest document it has seen, so at most MaxIdle
+ * are kept per thread; the rest are freed when their lease ends.
+ */
+class ParserPool {
+public:
+    static constexpr size_t MaxIdle = 4;
+
+    /**
+     * @brief Exclusive use of a pooled parser, returned to the pool of
+     * whichever thread destroys the lease.
+     */
+    class Lease {
+    public:
+        explicit Lease(std::unique_ptr<Parser> parser) : parser_(std::move(parser)) {
+        }
+
+        ~Lease();
+
+        Lease(Lease&&) noexcept = default;
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Parser& operator*() const { return *parser_; }
+        Parser* operator->() const { return parser_.get(); }
+
+    private:
+        std::unique_ptr<Parser> parser_;
+    };
+
+    /**
+     * @brief A parser of the calling thread, holding whatever document it
+     * was last reset() to.
+     */
+    static Lease acquire();
+
+    /**
+     * @brief A parser of the calling thread, reset to a JSON string.
+     */
+    static Lease acquire(std::string_view json);
+
+    /**
+     * @brief Number of parsers waiting in the calling thread's pool.
+     */
+    static size_t idle();
+};
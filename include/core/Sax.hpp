@@ -0,0 +1,284 @@
+#pragma once
+
+#include <core/ParseError.hpp>
+#include <core/TokenStream.hpp>
+
+#include <concepts>
+#include <expected>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Receives parse events.
+ *
+ * Every callback returns true to continue or false to stop the parse early.
+ * String and key views are only valid during the callback. Numbers are passed
+ * as their validated text; parseJsonNumber() converts them when needed, so
+ * handlers that skip numbers never pay for the conversion.
+ */
+template<typename Handler>
+concept JsonHandler = requires(Handler handler, std::string_view text, bool boolean) {
+    { handler.onStartObject() } -> std::convertible_to<bool>;
+    { handler.onKey(text) } -> std::convertible_to<bool>;
+    { handler.onEndObject() } -> std::convertible_to<bool>;
+    { handler.onStartArray() } -> std::convertible_to<bool>;
+    { handler.onEndArray() } -> std::convertible_to<bool>;
+    { handler.onString(text) } -> std::convertible_to<bool>;
+    { handler.onNumber(text) } -> std::convertible_to<bool>;
+    { handler.onBoolean(boolean) } -> std::convertible_to<bool>;
+    { handler.onNull() } -> std::convertible_to<bool>;
+};
+
+/**
+ * @brief A JsonHandler that ignores every event, for validating or skipping values.
+ */
+struct NullHandler {
+    bool onStartObject() { return true; }
+    bool onKey(std::string_view) { return true; }
+    bool onEndObject() { return true; }
+    bool onStartArray() { return true; }
+    bool onEndArray() { return true; }
+    bool onString(std::string_view) { return true; }
+    bool onNumber(std::string_view) { return true; }
+    bool onBoolean(bool) { return true; }
+    bool onNull() { return true; }
+};
+
+/**
+ * @brief The JSON grammar, emitting events to a handler instead of building values.
+ *
+ * The handler is a template parameter so its callbacks inline into the
+ * grammar. By default malformed input throws a ParseException; a reader
+ * constructed with a ParseError instead records the error there and returns
+ * false, so rejecting input never unwinds the stack.
+ *
+ * The grammar recurses once per nesting level and rejects documents nested
+ * deeper than MaxDepth, so its stack use is bounded.
+ */
+template<JsonHandler Handler>
+class SaxReader {
+public:
+    static constexpr size_t MaxDepth = 1024;
+
+    SaxReader(TokenStream& tokens, Handler& handler) : tokens_(tokens), handler_(handler) {
+    }
+
+    SaxReader(TokenStream& tokens, Handler& handler, ParseError& error)
+        : tokens_(tokens), handler_(handler), error_(&error) {
+    }
+
+    /**
+     * @brief Parses one value.
+     *
+     * @return false if the handler stopped the parse or, when errors are
+     * recorded, if the input is malformed.
+     */
+    bool parseValue() {
+        switch (const Token& token = tokens_.peek(); token.type) {
+            case TokenType::LeftBrace:
+                return parseObject();
+            case TokenType::LeftBracket:
+                return parseArray();
+            case TokenType::String:
+                return handler_.onString(tokens_.advance().value);
+            case TokenType::Number:
+                return handler_.onNumber(tokens_.advance().value);
+            case TokenType::Boolean:
+                return handler_.onBoolean(tokens_.advance().value == "true");
+            case TokenType::Null:
+                tokens_.advance();
+                return handler_.onNull();
+            default:
+                return fail(ParseErrorCode::UnexpectedToken, token);
+        }
+    }
+
+    /**
+     * @brief True if parseValue() returned false because of malformed input
+     * rather than because the handler stopped.
+     */
+    [[nodiscard]] bool failed() const { return failed_; }
+
+    /**
+     * @brief Counts the values parsed as nested this many levels deep, e.g.
+     * the elements of an array whose brackets were consumed elsewhere, so
+     * that they share the document's MaxDepth.
+     */
+    void setDepth(const size_t depth) { depth_ = depth; }
+
+private:
+    bool parseObject() {
+        const DepthGuard guard(depth_);
+        if (depth_ > MaxDepth) {
+            return fail(ParseErrorCode::TooDeep, tokens_.peek());
+        }
+        tokens_.advance();
+        if (!handler_.onStartObject()) {
+            return false;
+        }
+        if (tokens_.peek().type == TokenType::RightBrace) {
+            tokens_.advance();
+            return handler_.onEndObject();
+        }
+
+        while (true) {
+            if (tokens_.peek().type != TokenType::String) {
+                return fail(ParseErrorCode::ExpectedKey, tokens_.peek());
+            }
+            const Token key = tokens_.advance();
+            if (tokens_.peek().type != TokenType::Colon) {
+                return fail(ParseErrorCode::ExpectedColon, tokens_.peek());
+            }
+            tokens_.advance();
+            if (!handler_.onKey(key.value) || !parseValue()) {
+                return false;
+            }
+
+            if (const TokenType next = tokens_.peek().type; next == TokenType::Comma) {
+                tokens_.advance();
+            } else if (next == TokenType::RightBrace) {
+                tokens_.advance();
+                return handler_.onEndObject();
+            } else {
+                return fail(ParseErrorCode::ExpectedCommaOrEnd, tokens_.peek());
+            }
+        }
+    }
+
+    bool parseArray() {
+        const DepthGuard guard(depth_);
+        if (depth_ > MaxDepth) {
+            return fail(ParseErrorCode::TooDeep, tokens_.peek());
+        }
+        tokens_.advance();
+        if (!handler_.onStartArray()) {
+            return false;
+        }
+        if (tokens_.peek().type == TokenType::RightBracket) {
+            tokens_.advance();
+            return handler_.onEndArray();
+        }
+
+        while (true) {
+            if (!parseValue()) {
+                return false;
+            }
+
+            if (const TokenType next = tokens_.peek().type; next == TokenType::Comma) {
+                tokens_.advance();
+            } else if (next == TokenType::RightBracket) {
+                tokens_.advance();
+                return handler_.onEndArray();
+            } else {
+                return fail(ParseErrorCode::ExpectedCommaOrEnd, tokens_.peek());
+            }
+        }
+    }
+
+    /**
+     * Records or throws the error for an unexpected token. Running into the
+     * end of the input is always reported as UnexpectedEnd.
+     */
+    bool fail(ParseErrorCode code, const Token& token) {
+        if (token.type == TokenType::End) {
+            code = ParseErrorCode::UnexpectedEnd;
+        }
+        const ParseError error{code, 0, 0, token.offset};
+        if (error_ == nullptr) {
+            throw ParseException(error);
+        }
+        *error_ = error;
+        failed_ = true;
+        return false;
+    }
+
+    struct DepthGuard {
+        explicit DepthGuard(size_t& depth) : depth_(++depth) {
+        }
+        ~DepthGuard() { --depth_; }
+
+        size_t& depth_;
+    };
+
+    TokenStream& tokens_;
+    Handler& handler_;
+    ParseError* error_{};
+    bool failed_{};
+    size_t depth_{};
+};
+
+/**
+ * @brief Parses one value from a token stream, reporting it to a handler.
+ *
+ * @return false if the handler stopped the parse early.
+ * @throws ParseException on malformed input.
+ */
+template<JsonHandler Handler>
+bool parseEvents(TokenStream& tokens, Handler& handler) {
+    SaxReader<Handler> reader(tokens, handler);
+    return reader.parseValue();
+}
+
+/**
+ * @brief Parses JSON text, reporting its value to a handler. Tokens are
+ * pulled lazily and no DOM is built.
+ *
+ * @return false if the handler stopped the parse early.
+ * @throws ParseException, with line and column, on malformed input.
+ */
+template<JsonHandler Handler>
+bool parseEvents(const std::string_view json, Handler& handler) {
+    Tokenizer tokenizer(json);
+    TokenStream tokens(tokenizer);
+    ParseError error;
+    SaxReader<Handler> reader(tokens, handler, error);
+    if (reader.parseValue()) {
+        return true;
+    }
+    if (reader.failed()) {
+        throw ParseException(error.locate(json));
+    }
+    return false;
+}
+
+/**
+ * @brief Parses the tokenizer's text, which must hold exactly one value,
+ * reporting malformed input as a ParseError instead of throwing.
+ *
+ * The grammar and the tokenizer both record their errors, so nothing is
+ * thrown unless the handler itself throws. The tokenizer must not have
+ * produced any tokens yet.
+ *
+ * @return true if the whole text was parsed, false if the handler stopped
+ * the parse, or the error with its line and column.
+ */
+template<JsonHandler Handler>
+std::expected<bool, ParseError> tryParseEvents(Tokenizer& tokenizer, Handler& handler) {
+    tokenizer.setRecordErrors(true);
+    TokenStream tokens(tokenizer);
+    ParseError error;
+    SaxReader<Handler> reader(tokens, handler, error);
+
+    if (!reader.parseValue()) {
+        if (tokens.peek().type == TokenType::Error) {
+            error = tokenizer.error();
+        } else if (!reader.failed()) {
+            return false;
+        }
+    } else if (tokens.peek().type != TokenType::End) {
+        error = ParseError{ParseErrorCode::TrailingContent, 0, 0, tokens.peek().offset};
+    } else {
+        return true;
+    }
+    return std::unexpected(error.locate(tokenizer.text()));
+}
+
+/**
+ * @brief As tryParseEvents(Tokenizer&, Handler&), with a default tokenizer over the text.
+ */
+template<JsonHandler Handler>
+std::expected<bool, ParseError> tryParseEvents(const std::string_view json, Handler& handler) {
+    Tokenizer tokenizer(json);
+    return tryParseEvents(tokenizer, handler);
+}
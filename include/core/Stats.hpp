@@ -0,0 +1,193 @@
+#pragma once
+
+#include <core/Parser.hpp>
+#include <core/Sax.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Whether heap allocations are counted.
+ *
+ * Counting replaces the global allocation functions, so it is compiled in
+ * only by the JSON_STATS build option. Without it every HeapCounters value
+ * is zero and nothing else in the library changes.
+ */
+#ifdef JSON_STATS
+inline constexpr bool HeapStatsEnabled = true;
+#else
+inline constexpr bool HeapStatsEnabled = false;
+#endif
+
+/**
+ * @brief Calls to the global operator new and the bytes they requested.
+ */
+struct HeapCounters {
+    uint64_t allocations{};
+    uint64_t bytes{};
+
+    HeapCounters operator-(const HeapCounters& other) const {
+        return {allocations - other.allocations, bytes - other.bytes};
+    }
+};
+
+/**
+ * @brief Heap use of the whole process so far, or zero unless HeapStatsEnabled.
+ */
+HeapCounters heapCounters() noexcept;
+
+/**
+ * @brief Measurements of one phase of a parse.
+ */
+struct PhaseStats {
+    std::string name;
+    double milliseconds{}; ///< Wall time.
+    size_t bytes{}; ///< Input bytes processed, or 0 if the phase does not read input.
+    HeapCounters heap; ///< Allocations made during the phase.
+};
+
+/**
+ * @brief Measurements of a parse, filled in by parseWithStats() or by hand
+ * with PhaseTimer and CountingHandler.
+ */
+struct ParseStats {
+    std::vector<PhaseStats> phases; ///< In the order they ran.
+    size_t inputBytes{};
+    size_t tokens{};
+    size_t nodes{}; ///< Values of every type, containers included.
+    size_t maxDepth{}; ///< Deepest container nesting; 0 for a scalar document.
+
+    /**
+     * @return The phase with the given name, or nullptr if it did not run.
+     */
+    [[nodiscard]] const PhaseStats* phase(std::string_view name) const;
+
+    [[nodiscard]] double totalMilliseconds() const;
+
+    /**
+     * @brief The stats as one line of JSON, for scraping. Heap fields are
+     * null unless HeapStatsEnabled.
+     */
+    [[nodiscard]] std::string toJson() const;
+
+    /**
+     * @brief The stats as a human-readable table.
+     */
+    [[nodiscard]] std::string toText() const;
+};
+
+/**
+ * @brief Records the wall time and allocations of a phase into ParseStats.
+ *
+ * The phase ends when stop() is called or the timer is destroyed.
+ */
+class PhaseTimer {
+public:
+    PhaseTimer(ParseStats& stats, std::string name, size_t bytes = 0);
+    ~PhaseTimer() { stop(); }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    void stop();
+
+private:
+    ParseStats* stats_;
+    PhaseStats phase_;
+    std::chrono::steady_clock::time_point start_;
+    HeapCounters heapStart_;
+};
+
+/**
+ * @brief A JsonHandler that counts values and nesting depth, then forwards
+ * every event to another handler.
+ *
+ * Counting is a template wrapper rather than a runtime flag, so parses that
+ * do not use it pay nothing.
+ */
+template<JsonHandler Handler>
+class CountingHandler {
+public:
+    explicit CountingHandler(Handler& inner) : inner_(inner) {
+    }
+
+    bool onStartObject() {
+        enter();
+        return inner_.onStartObject();
+    }
+
+    bool onKey(const std::string_view key) { return inner_.onKey(key); }
+
+    bool onEndObject() {
+        --depth_;
+        return inner_.onEndObject();
+    }
+
+    bool onStartArray() {
+        enter();
+        return inner_.onStartArray();
+    }
+
+    bool onEndArray() {
+        --depth_;
+        return inner_.onEndArray();
+    }
+
+    bool onString(const std::string_view value) {
+        ++nodes_;
+        return inner_.onString(value);
+    }
+
+    bool onNumber(const std::string_view text) {
+        ++nodes_;
+        return inner_.onNumber(text);
+    }
+
+    bool onBoolean(const bool value) {
+        ++nodes_;
+        return inner_.onBoolean(value);
+    }
+
+    bool onNull() {
+        ++nodes_;
+        return inner_.onNull();
+    }
+
+    [[nodiscard]] size_t nodes() const { return nodes_; }
+    [[nodiscard]] size_t maxDepth() const { return maxDepth_; }
+
+private:
+    void enter() {
+        ++nodes_;
+        if (++depth_ > maxDepth_) {
+            maxDepth_ = depth_;
+        }
+    }
+
+    Handler& inner_;
+    size_t nodes_{};
+    size_t depth_{};
+    size_t maxDepth_{};
+};
+
+/**
+ * @brief Parses a JSON string or file into a JsonValue tree, recording each
+ * phase separately: "read" (files only, with FileReader), "tokenize" and
+ * "parse".
+ *
+ * The phases run one after another so each can be timed on its own, which
+ * makes this slower than Parser::parse(); use it to find where time goes.
+ *
+ * @throws ParseException on malformed input.
+ * @throws std::runtime_error if the file cannot be read.
+ */
+std::shared_ptr<JsonValue> parseWithStats(const std::string& inputOrFilePath, bool isFile, ParseStats& stats);
+
+/**
+ * @brief Frees a tree, recording it as the "free" phase.
+ */
+void releaseWithStats(std::shared_ptr<JsonValue>& root, ParseStats& stats);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <core/Parser.hpp>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief An incremental parser for JSON that arrives in pieces.
+ *
+ * Bytes are pushed in with feed() as they arrive, e.g. straight from a socket
+ * or pipe. Tokenizer and grammar state are kept across calls, including a
+ * string, number or keyword cut in half by a chunk boundary. The input may
+ * hold any number of whitespace-separated top-level values; each one is
+ * emitted as soon as it closes.
+ *
+ * Only the bytes of a token cut by a chunk boundary are retained between
+ * calls, so memory is bounded by the values being built, not by the stream.
+ * Errors are still located in the whole stream: the parser counts the lines
+ * of the bytes it has consumed.
+ *
+ * After a syntax error the parser is left in an unspecified state and must
+ * not be fed again.
+ */
+class StreamingParser {
+public:
+    using ValueCallback = std::function<void(std::shared_ptr<JsonValue>)>;
+
+    /**
+     * @brief Collects completed values until takeValues() is called.
+     */
+    StreamingParser() = default;
+
+    /**
+     * @brief Hands every completed value to a callback instead.
+     */
+    explicit StreamingParser(ValueCallback onValue);
+
+    /**
+     * @brief Parses the next piece of input.
+     *
+     * @throws ParseException, with line and column in the whole stream, on
+     * malformed input.
+     */
+    void feed(std::string_view chunk);
+
+    /**
+     * @brief Signals the end of the input.
+     *
+     * @throws ParseException if the input ends inside a value.
+     */
+    void finish();
+
+    /**
+     * @brief Takes the values completed so far.
+     */
+    std::vector<std::shared_ptr<JsonValue>> takeValues();
+
+private:
+    enum class State {
+        Value,
+        FirstElementOrEnd,
+        CommaOrEndArray,
+        FirstKeyOrEnd,
+        Key,
+        Colon,
+        CommaOrEndObject
+    };
+
+    size_t process(std::string_view input, bool partial);
+    void processToken(const Token& token);
+    void startValue(const Token& token);
+    void afterValue();
+    size_t completionLength(std::string_view chunk) const;
+    void consume(std::string_view bytes);
+    [[noreturn]] static void fail(ParseErrorCode code, size_t offset);
+    [[nodiscard]] ParseError locate(ParseError error, std::string_view input) const;
+
+    ValueCallback onValue_;
+    std::deque<std::shared_ptr<JsonValue>> values_;
+    DomBuilder builder_;
+    std::vector<bool> containers_; ///< true for an object, false for an array.
+    State state_{State::Value};
+    std::string pending_; ///< A token cut by the end of the previous chunk.
+    Tokenizer tokenizer_{std::string_view()};
+    size_t offset_{}; ///< Offset in the stream of the first byte not consumed yet.
+    uint32_t line_{1}; ///< Line of that byte.
+    size_t lineStart_{}; ///< Offset in the stream where that line starts.
+};
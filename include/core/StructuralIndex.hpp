@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Positions of every structural character of a JSON text.
+ *
+ * The index is built in one vectorized pass over the input, 64 bytes at a
+ * time. It records, in increasing order, the offset of:
+ *  - every `{`, `}`, `[`, `]`, `:` and `,` outside a string,
+ *  - every unescaped quote (so each string contributes its opening and its
+ *    closing quote),
+ *  - the first byte of every number or keyword.
+ *
+ * Nothing inside a string is indexed, so a Tokenizer driven by the index can
+ * jump from one token to the next without looking at whitespace or string
+ * contents.
+ */
+class StructuralIndex {
+public:
+    /**
+     * @brief The classification kernel that build() uses.
+     */
+    enum class Kernel {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    StructuralIndex() = default;
+
+    /**
+     * @brief Indexes a JSON text with the best kernel this CPU supports.
+     */
+    explicit StructuralIndex(std::string_view json);
+
+    /**
+     * @brief Indexes a JSON text with a specific kernel.
+     *
+     * Requesting a kernel the CPU does not support falls back to the best one
+     * that is supported.
+     */
+    StructuralIndex(std::string_view json, Kernel kernel);
+
+    /**
+     * @brief The kernel selected at runtime for this CPU.
+     */
+    static Kernel bestKernel();
+
+    /**
+     * @brief Finds where the elements of a root container begin and end,
+     * without indexing anything else.
+     *
+     * Returns the offset of every bracket or brace that opens or closes a
+     * value at the top level, and of every comma directly inside one. For
+     * `[1, [2, 3], 4]` that is the outer brackets and the two outer commas.
+     * Memory is proportional to the number of top-level elements rather than
+     * to the size of the input.
+     */
+    static std::vector<size_t> topLevelSeparators(std::string_view json);
+
+    [[nodiscard]] const std::vector<size_t>& positions() const { return positions_; }
+    [[nodiscard]] size_t size() const { return positions_.size(); }
+    size_t operator[](const size_t i) const { return positions_[i]; }
+
+    /**
+     * @brief True if the input ends inside a string.
+     */
+    [[nodiscard]] bool unterminatedString() const { return unterminatedString_; }
+
+private:
+    std::vector<size_t> positions_;
+    bool unterminatedString_{};
+};
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <core/Document.hpp>
+#include <core/ParseError.hpp>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <expected>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief The kind of a tape word, stored in its top byte.
+ */
+enum class TapeTag : uint8_t {
+    ObjectStart = '{', ///< Payload: distance to the matching ObjectEnd.
+    ObjectEnd = '}',   ///< Payload: number of members.
+    ArrayStart = '[',  ///< Payload: distance to the matching ArrayEnd.
+    ArrayEnd = ']',    ///< Payload: number of elements.
+    String = '"',      ///< Payload: offset in the string buffer. The next word is the length.
+    Int64 = 'l',       ///< The next word is the value.
+    UInt64 = 'u',      ///< The next word is the value.
+    Double = 'd',      ///< The next word is the value's bit pattern.
+    True = 't',
+    False = 'f',
+    Null = 'n'
+};
+
+/**
+ * @brief What a tag stands for: the type of its value and whether a second
+ * word holding the value follows it.
+ */
+struct TapeKind {
+    DomType type;
+    bool twoWords;
+};
+
+/**
+ * @brief TapeKind of every tag, indexed by tag, so that classifying a word is
+ * a table lookup instead of a switch.
+ */
+inline constexpr std::array<TapeKind, 256> TapeKinds = [] {
+    std::array<TapeKind, 256> kinds{};
+    const auto set = [&](const TapeTag tag, const DomType type, const bool twoWords = false) {
+        kinds[static_cast<uint8_t>(tag)] = TapeKind{type, twoWords};
+    };
+    set(TapeTag::ObjectStart, DomType::Object);
+    set(TapeTag::ObjectEnd, DomType::Object);
+    set(TapeTag::ArrayStart, DomType::Array);
+    set(TapeTag::ArrayEnd, DomType::Array);
+    set(TapeTag::String, DomType::String, true);
+    set(TapeTag::Int64, DomType::Number, true);
+    set(TapeTag::UInt64, DomType::Number, true);
+    set(TapeTag::Double, DomType::Number, true);
+    set(TapeTag::True, DomType::Boolean);
+    set(TapeTag::False, DomType::Boolean);
+    set(TapeTag::Null, DomType::Null);
+    return kinds;
+}();
+
+/**
+ * @brief Helpers for the 64-bit words of a tape: an 8-bit TapeTag above a
+ * 56-bit payload.
+ */
+struct TapeWord {
+    static constexpr uint64_t PayloadMask = (uint64_t{1} << 56) - 1;
+
+    static constexpr uint64_t make(const TapeTag tag, const uint64_t payload = 0) {
+        return uint64_t{static_cast<uint8_t>(tag)} << 56 | payload;
+    }
+
+    static constexpr TapeTag tag(const uint64_t word) { return static_cast<TapeTag>(word >> 56); }
+    static constexpr uint64_t payload(const uint64_t word) { return word & PayloadMask; }
+
+    static constexpr bool hasValueWord(const TapeTag tag) { return TapeKinds[static_cast<uint8_t>(tag)].twoWords; }
+
+    static constexpr DomType type(const TapeTag tag) { return TapeKinds[static_cast<uint8_t>(tag)].type; }
+};
+
+/**
+ * @brief A cursor on a value of a tape.
+ *
+ * A TapeRef is two pointers, to the value's first word and to the string
+ * buffer, so it is passed in registers and never owns anything. Moving to a
+ * sibling skips a whole container in one step using the distance stored in
+ * its start word.
+ *
+ * A default-constructed TapeRef refers to nothing and converts to false; it
+ * is what find() returns for a missing key. Cursors are only valid while the
+ * tape they point into is alive.
+ */
+class TapeRef {
+public:
+    class ElementIterator;
+    class MemberIterator;
+
+    /**
+     * @brief A pair of iterators usable in range-based for loops.
+     */
+    template<typename Iterator>
+    struct Range {
+        Iterator first;
+        Iterator last;
+
+        [[nodiscard]] Iterator begin() const { return first; }
+        [[nodiscard]] Iterator end() const { return last; }
+    };
+
+    TapeRef() = default;
+
+    /**
+     * @brief A cursor on the value starting at the given word of a tape.
+     */
+    TapeRef(const uint64_t* word, const char* strings) : word_(word), strings_(strings) {
+    }
+
+    explicit operator bool() const { return word_ != nullptr; }
+
+    [[nodiscard]] DomType type() const { return TapeWord::type(tag()); }
+
+    [[nodiscard]] bool isObject() const { return type() == DomType::Object; }
+    [[nodiscard]] bool isArray() const { return type() == DomType::Array; }
+    [[nodiscard]] bool isString() const { return type() == DomType::String; }
+    [[nodiscard]] bool isNumber() const { return type() == DomType::Number; }
+    [[nodiscard]] bool isBoolean() const { return type() == DomType::Boolean; }
+    [[nodiscard]] bool isNull() const { return type() == DomType::Null; }
+
+    [[nodiscard]] std::string_view asString() const;
+
+    /**
+     * @brief The value of any number, converted to double if it is integral.
+     */
+    [[nodiscard]] double asNumber() const {
+        switch (tag()) {
+            case TapeTag::Int64: return static_cast<double>(static_cast<int64_t>(word(1)));
+            case TapeTag::UInt64: return static_cast<double>(word(1));
+            case TapeTag::Double: return std::bit_cast<double>(word(1));
+            default: throwTypeMismatch("number");
+        }
+    }
+
+    /**
+     * @throws std::runtime_error if the number is not an integer that fits.
+     */
+    [[nodiscard]] int64_t asInt64() const;
+
+    /**
+     * @throws std::runtime_error if the number is not a non-negative integer.
+     */
+    [[nodiscard]] uint64_t asUInt64() const;
+
+    [[nodiscard]] NumberType numberType() const;
+    [[nodiscard]] bool asBoolean() const;
+
+    /**
+     * @brief Number of elements of an array or members of an object.
+     */
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] Range<ElementIterator> elements() const;
+    [[nodiscard]] Range<MemberIterator> members() const;
+
+    /**
+     * @brief Walks the array to the element, skipping earlier containers whole.
+     *
+     * @throws std::runtime_error if this is not an array or the index is out of range.
+     */
+    TapeRef operator[](size_t index) const;
+
+    /**
+     * @throws std::runtime_error if this is not an object or the key is missing.
+     */
+    TapeRef operator[](std::string_view key) const;
+
+    /**
+     * @brief Looks up a key in an object.
+     *
+     * @return The value, or an empty TapeRef if the key is missing.
+     */
+    [[nodiscard]] TapeRef find(std::string_view key) const;
+
+private:
+    [[nodiscard]] TapeTag tag() const {
+        if (word_ == nullptr) {
+            throwEmpty();
+        }
+        return TapeWord::tag(word());
+    }
+
+    [[noreturn]] static void throwEmpty();
+    [[noreturn]] void throwTypeMismatch(const char* expected) const;
+    [[nodiscard]] uint64_t word(const size_t offset = 0) const { return word_[offset]; }
+    [[nodiscard]] TapeRef at(const size_t offset) const { return {word_ + offset, strings_}; }
+
+    /**
+     * The text of a string word, without checking its tag.
+     */
+    [[nodiscard]] std::string_view text() const { return {strings_ + TapeWord::payload(word()), word(1)}; }
+
+    /**
+     * Number of words this value takes.
+     */
+    [[nodiscard]] size_t length() const {
+        const uint64_t first = word();
+        const TapeTag tag = TapeWord::tag(first);
+        if (tag == TapeTag::ObjectStart || tag == TapeTag::ArrayStart) {
+            return TapeWord::payload(first) + 1;
+        }
+        return TapeWord::hasValueWord(tag) ? 2 : 1;
+    }
+
+    /**
+     * Distance to the end word of this container.
+     */
+    [[nodiscard]] size_t end(TapeTag expected) const;
+
+    const uint64_t* word_{};
+    const char* strings_{};
+};
+
+/**
+ * @brief A member of an object on a tape.
+ */
+struct TapeMember {
+    std::string_view key;
+    TapeRef value;
+};
+
+class TapeRef::ElementIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = TapeRef;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = TapeRef;
+
+    ElementIterator() = default;
+    explicit ElementIterator(const TapeRef current) : current_(current) {
+    }
+
+    TapeRef operator*() const { return current_; }
+
+    ElementIterator& operator++() {
+        current_ = current_.at(current_.length());
+        return *this;
+    }
+
+    ElementIterator operator++(int) {
+        const ElementIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    bool operator==(const ElementIterator& other) const { return current_.word_ == other.current_.word_; }
+
+private:
+    TapeRef current_;
+};
+
+class TapeRef::MemberIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = TapeMember;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = TapeMember;
+
+    MemberIterator() = default;
+    explicit MemberIterator(const TapeRef key) : key_(key) {
+    }
+
+    TapeMember operator*() const { return {key_.text(), key_.at(2)}; }
+
+    MemberIterator& operator++() {
+        key_ = key_.at(2 + key_.at(2).length());
+        return *this;
+    }
+
+    MemberIterator operator++(int) {
+        const MemberIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    bool operator==(const MemberIterator& other) const { return key_.word_ == other.key_.word_; }
+
+private:
+    TapeRef key_;
+};
+
+/**
+ * @brief A parsed JSON document stored as a flat tape of 64-bit words.
+ *
+ * Every value takes one word, two for strings and numbers, in document
+ * order. A container's start word holds the distance to its end word, and
+ * the end word holds its size, so skipping or sizing a container is O(1).
+ * Object members are a string word for the key followed by the value.
+ * Decoded strings live in a separate byte buffer.
+ *
+ * A tape is two buffers in total, so building it costs a few allocations,
+ * copying it is two memcpys and destroying it is two frees. Traversal reads
+ * memory sequentially instead of chasing pointers. It is built by the same
+ * SaxReader grammar as Parser and Document.
+ */
+class Tape {
+public:
+    /**
+     * @brief Parses JSON text. The input may be discarded afterwards.
+     *
+     * @throws ParseException on malformed input.
+     */
+    static Tape parse(std::string_view json);
+
+    /**
+     * @brief Parses JSON text without throwing, like Document::tryParse().
+     */
+    static std::expected<Tape, ParseError> tryParse(std::string_view json) noexcept;
+
+    /**
+     * @brief Parses a file by memory-mapping it.
+     *
+     * @throws std::runtime_error if the file cannot be read or is malformed.
+     */
+    static Tape parseFile(const std::string& path);
+
+    [[nodiscard]] TapeRef root() const { return {words_.data(), strings_.data()}; }
+
+    [[nodiscard]] std::span<const uint64_t> words() const { return words_; }
+    [[nodiscard]] std::string_view strings() const { return strings_; }
+
+    /**
+     * @brief Bytes used by the tape and the string buffer.
+     */
+    [[nodiscard]] size_t memoryUsage() const { return words_.size() * sizeof(uint64_t) + strings_.size(); }
+
+private:
+    Tape() = default;
+
+    std::vector<uint64_t> words_;
+    std::string strings_;
+};
+
+/**
+ * @brief Converts a value of a Tape to a shared_ptr based JsonValue tree.
+ */
+std::shared_ptr<JsonValue> toJsonValue(TapeRef value);
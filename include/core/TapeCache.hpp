@@ -0,0 +1,110 @@
+#pragma once
+
+#include <core/MappedFile.hpp>
+#include <core/Tape.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+
+/**
+ * @brief A read-only tape loaded through a TapeCache: either mapped from a
+ * cached image or, on a miss, freshly parsed.
+ */
+class CachedTape {
+public:
+    [[nodiscard]] TapeRef root() const { return {words().data(), strings().data()}; }
+
+    [[nodiscard]] std::span<const uint64_t> words() const {
+        const Tape* tape = std::get_if<Tape>(&storage_);
+        return tape ? tape->words() : words_;
+    }
+
+    [[nodiscard]] std::string_view strings() const {
+        const Tape* tape = std::get_if<Tape>(&storage_);
+        return tape ? tape->strings() : strings_;
+    }
+
+    /**
+     * @brief True if the tape was mapped from an existing image rather than parsed.
+     */
+    [[nodiscard]] bool fromCache() const { return fromCache_; }
+
+private:
+    friend class TapeCache;
+
+    explicit CachedTape(Tape tape);
+    CachedTape(MappedFile image, std::span<const uint64_t> words, std::string_view strings);
+
+    std::variant<Tape, MappedFile> storage_;
+    // Views of a mapped image, which stay put when the MappedFile is moved.
+    // A Tape's buffers are asked for each time, as a short string moves with it.
+    std::span<const uint64_t> words_;
+    std::string_view strings_;
+    bool fromCache_{};
+};
+
+struct TapeCacheOptions {
+    /**
+     * @brief Hash the source file on every load and compare it with the
+     * image, instead of trusting a matching size and modification time.
+     *
+     * Hashing reads the whole file but is far cheaper than parsing it, and
+     * it catches edits that keep the size within the timestamp resolution.
+     */
+    bool verifyContent = true;
+};
+
+/**
+ * @brief An opt-in, on-disk cache of parsed JSON files.
+ *
+ * The first load of a file parses it into a Tape and writes the tape's two
+ * buffers to an image in the cache directory. The tape is position
+ * independent, with containers storing relative distances and strings
+ * storing offsets into their buffer. A later load therefore maps the image
+ * and uses it in place, with no reading, tokenizing or parsing of the JSON.
+ *
+ * An image records the source's absolute path, size, modification time and
+ * a 64-bit content hash, and is only used while they all match. Otherwise,
+ * and whenever the image is unreadable, the file is parsed again and the
+ * image replaced. Images are written to a temporary file and renamed into
+ * place, so concurrent loaders never see a partial one. A cache that cannot
+ * be written only costs speed: the parsed tape is still returned.
+ *
+ * Images are in the host's byte order and are rejected elsewhere. The hash
+ * detects changes, not tampering, so the cache directory must be trusted.
+ */
+class TapeCache {
+public:
+    explicit TapeCache(std::string directory, TapeCacheOptions options = {});
+
+    /**
+     * @brief Loads a JSON file through the cache.
+     *
+     * @throws std::runtime_error if the file cannot be read.
+     * @throws ParseException if it has to be parsed and is malformed.
+     */
+    [[nodiscard]] CachedTape load(const std::string& path) const;
+
+    /**
+     * @brief Where the image of a file is kept.
+     */
+    [[nodiscard]] std::string imagePath(const std::string& path) const;
+
+    /**
+     * @brief Deletes the image of a file, if there is one.
+     */
+    void invalidate(const std::string& path) const;
+
+private:
+    std::string directory_;
+    TapeCacheOptions options_;
+};
+
+/**
+ * @brief A fast 64-bit hash of a byte string, for detecting changed content.
+ * Not cryptographic.
+ */
+uint64_t contentHash(std::string_view bytes);
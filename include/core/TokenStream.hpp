@@ -0,0 +1,90 @@
+#pragma once
+
+#include <core/Tokenizer.hpp>
+
+#include <span>
+
+/**
+ * @brief A token source with one token of lookahead.
+ *
+ * Tokens are either pulled lazily from a Tokenizer or read from an existing
+ * span of tokens. The first token is fetched on construction.
+ *
+ * Errors are thrown as ParseExceptions with the offending token's offset but
+ * no line or column; callers holding the text locate() them.
+ */
+class TokenStream {
+public:
+    explicit TokenStream(Tokenizer& tokenizer) : tokenizer_(&tokenizer), lookahead_(tokenizer.next()) {
+    }
+
+    /**
+     * @param endOffset The offset reported for the end of the tokens, such
+     * as the size of the text they were read from.
+     */
+    explicit TokenStream(const std::span<const Token> tokens, const size_t endOffset = 0)
+        : tokens_(tokens), endOffset_(endOffset), lookahead_(fetch()) {
+    }
+
+    [[nodiscard]] const Token& peek() const { return lookahead_; }
+
+    /**
+     * @brief Consumes the lookahead token.
+     *
+     * @throws ParseException at the end of the input.
+     */
+    Token advance() {
+        if (lookahead_.type == TokenType::End) {
+            throw ParseException(ParseError{ParseErrorCode::UnexpectedEnd, 0, 0, lookahead_.offset});
+        }
+
+        const Token current = lookahead_;
+        lookahead_ = fetch();
+        return current;
+    }
+
+    /**
+     * @brief Consumes the lookahead token, which must be of the given type.
+     *
+     * @throws ParseException at the lookahead token if it is not.
+     */
+    void expect(const TokenType type) {
+        if (lookahead_.type != type) {
+            throw ParseException(ParseError{expectedCode(type), 0, 0, lookahead_.offset});
+        }
+        advance();
+    }
+
+private:
+    [[nodiscard]] ParseErrorCode expectedCode(const TokenType type) const {
+        if (lookahead_.type == TokenType::End) {
+            return ParseErrorCode::UnexpectedEnd;
+        }
+        switch (type) {
+            case TokenType::String: return ParseErrorCode::ExpectedKey;
+            case TokenType::Colon: return ParseErrorCode::ExpectedColon;
+            case TokenType::Comma:
+            case TokenType::RightBrace:
+            case TokenType::RightBracket: return ParseErrorCode::ExpectedCommaOrEnd;
+            default: return ParseErrorCode::UnexpectedToken;
+        }
+    }
+
+    Token fetch() {
+        if (tokenizer_ != nullptr) {
+            return tokenizer_->next();
+        }
+
+        if (currentIndex_ < tokens_.size()) {
+            return tokens_[currentIndex_++];
+        }
+
+        return Token(TokenType::End, {}, endOffset_);
+    }
+
+    Tokenizer* tokenizer_{};
+    std::span<const Token> tokens_;
+    size_t currentIndex_{};
+    size_t endOffset_{};
+    Token lookahead_;
+};
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <core/Arena.hpp>
+#include <core/ParseError.hpp>
+#include <core/StructuralIndex.hpp>
+
+#include <cstddef>
+#include <memory>
 #include <string>
-#include <utility>
+#include <string_view>
 #include <vector>
 
 enum class TokenType {
@@ -15,42 +21,163 @@ enum class TokenType {
     Number,
     Boolean,
     Null,
-    Unknown
+    Unknown,
+    End,
+    Error ///< Produced instead of throwing when the tokenizer records errors.
 };
 
+/**
+ * @brief A readable name for a token type, such as "'{'" or "string".
+ */
+const char* tokenTypeName(TokenType type);
+
 /**
  * @brief Represents a token in the tokenizer.
  * 
  * A token consists of a type and a value. The type indicates the kind of token
- * (e.g., string, number, etc.), and the value holds the actual content of the token.
+ * (e.g., string, number, etc.), and the value is a view into the tokenizer's
+ * input buffer, so producing a token never allocates. The one exception is a
+ * string with escapes, whose value is its decoded text held by the tokenizer
+ * (see Tokenizer for how long it stays valid).
  */
 struct Token {
     TokenType type; ///< The type of the token.
-    std::string value; ///< The value of the token.
+    std::string_view value; ///< The text of the token (string tokens are decoded and exclude the quotes).
+    size_t offset{}; ///< Byte offset of the token in the input.
     
     /**
      * @brief Constructs a Token with the specified type and value.
      * 
      * @param t The type of the token.
      * @param v The value of the token.
+     * @param off The byte offset of the token in the input.
      */
-    explicit Token(const TokenType t, std::string v) : type(t), value(std::move(v)) {}
+    explicit Token(const TokenType t, const std::string_view v, const size_t off = 0) : type(t), value(v), offset(off) {}
 };
 
+/**
+ * @brief Splits JSON text into tokens.
+ *
+ * The tokenizer does not copy its input: tokens refer to the caller's buffer,
+ * which must outlive both the tokenizer and every token it produces.
+ *
+ * Strings without escapes are referenced in place. Strings with escapes are
+ * decoded to UTF-8 into storage owned by the tokenizer, so such tokens must
+ * not outlive it. tokenize() keeps every decoded string until reset(). next()
+ * decodes into two buffers in turn, so that memory does not grow with the
+ * document: a decoded string stays valid until the second one after it, which
+ * covers the current token and the lookahead.
+ */
 class Tokenizer {
 public:
     using TokenVector = std::vector<Token>;
 
-    explicit Tokenizer(std::string  json);
+    explicit Tokenizer(std::string_view json);
+
+    /**
+     * @brief Tokenizes with the help of a StructuralIndex of the same input.
+     *
+     * Instead of walking every byte, the tokenizer jumps from one indexed
+     * position to the next, skipping whitespace and string contents. The
+     * index must outlive the tokenizer.
+     */
+    Tokenizer(std::string_view json, const StructuralIndex& index);
+
+    /**
+     * @brief Starts over on a new input, as if freshly constructed, but keeps
+     * the settings and the storage for decoded strings.
+     *
+     * Tokens of the previous input that hold decoded strings are invalidated.
+     */
+    void reset(std::string_view json);
+
+    /**
+     * @brief As reset(std::string_view), tokenizing with the help of an index
+     * of the new input.
+     */
+    void reset(std::string_view json, const StructuralIndex& index);
+
     TokenVector tokenize();
+
+    /**
+     * @brief Tokenizes the rest of the input into a caller's vector, which is
+     * cleared first. Reusing one vector across documents keeps its capacity.
+     */
+    void tokenize(TokenVector& tokens);
+
+    /**
+     * @brief Produces the next token of the input.
+     *
+     * @return The next token, or a token of type TokenType::End once the
+     * input is exhausted.
+     */
+    Token next();
+
+    /**
+     * @brief Marks the input as possibly truncated, e.g. the first part of a
+     * stream whose next chunk has not arrived yet.
+     *
+     * A string, number or keyword that runs into the end of a partial input
+     * is not returned: next() returns TokenType::End instead and position()
+     * stays at the start of the cut token.
+     */
+    void setPartial(const bool isPartial) { partial = isPartial; }
+
+    /**
+     * @brief Makes lexical errors produce a TokenType::Error token and be kept
+     * in error(), instead of throwing a ParseException. Once an error has
+     * occurred every later call to next() returns the same Error token.
+     */
+    void setRecordErrors(const bool record) { recordErrors = record; }
+
+    /**
+     * @brief Controls whether escapes in strings are decoded (the default).
+     *
+     * Escapes are validated either way. Without decoding, string tokens are
+     * always views of the raw input and the tokenizer never allocates.
+     */
+    void setDecodeEscapes(const bool decode) { decodeEscapes = decode; }
+
+    /**
+     * @brief The text being tokenized.
+     */
+    [[nodiscard]] std::string_view text() const { return input; }
+
+    /**
+     * @brief The recorded error, valid once next() has returned TokenType::Error.
+     */
+    [[nodiscard]] const ParseError& error() const { return lastError; }
+
+    /**
+     * @brief Offset of the first byte not consumed yet.
+     */
+    [[nodiscard]] size_t position() const { return currentIndex; }
 private:
-    std::string input;
+    std::string_view input;
     size_t currentIndex{};
+    const StructuralIndex* index{};
+    size_t indexPosition{};
+    bool partial{};
+    bool recordErrors{};
+    bool failed{};
+    bool decodeEscapes{true};
+    ParseError lastError;
+    std::unique_ptr<Arena> strings; ///< Decoded strings kept by tokenize(), created on the first escape.
+    std::string scratch[2]; ///< Decoded strings from next(), used in turn.
+    bool scratchTurn{};
+    bool keepStrings{}; ///< Decode into strings rather than scratch.
+
+    static constexpr size_t StringBlockSize = 4096;
 
     [[nodiscard]] char peek() const;
     char advance();
     void skipWhiteSpace();
 
+    Token nextIndexed();
+    Token nextToken();
+    Token cutToken(size_t start);
+    Token fail(ParseErrorCode code, size_t offset);
+
     Token parseString();
     Token parseNumber();
     Token parseKeyword();
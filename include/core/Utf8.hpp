@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief Length of the longest prefix of string contents that needs no
+ * further checking: printable ASCII other than '"' and '\\'.
+ *
+ * The scan is vectorized, 32 bytes at a time with AVX2 and 16 with SSE2,
+ * and stops at a quote, a backslash, a control character or a non-ASCII byte.
+ */
+size_t plainStringPrefix(std::string_view text);
+
+/**
+ * @brief Length of the longest prefix of string contents made of complete,
+ * well-formed UTF-8 sequences other than '"', '\\' and control characters.
+ *
+ * With AVX2, multibyte text is validated 32 bytes at a time with the lookup
+ * tables of Keiser and Lemire, and runs of ASCII only need the special-byte
+ * check. Elsewhere, and for the last partial block, ASCII runs are scanned
+ * with plainStringPrefix() and each multibyte sequence is checked with
+ * utf8SequenceLength().
+ */
+size_t stringContentPrefix(std::string_view text);
+
+/**
+ * @brief Length of the well-formed UTF-8 sequence at the start of the text.
+ *
+ * Overlong encodings, UTF-16 surrogates and code points above U+10FFFF are
+ * rejected, as RFC 3629 requires.
+ *
+ * @return 1 to 4, or 0 if the text does not start with a valid sequence.
+ */
+size_t utf8SequenceLength(std::string_view text);
+
+/**
+ * @brief Length of the JSON escape sequence at the start of the text, which
+ * must begin with a backslash.
+ *
+ * A UTF-16 surrogate pair written as two \uXXXX escapes is one sequence.
+ * Unpaired surrogates cannot be represented in UTF-8 and are invalid.
+ *
+ * @return 2 for a single-character escape, 6 for \uXXXX, 12 for a surrogate
+ * pair, or 0 if the escape is invalid.
+ */
+size_t escapeLength(std::string_view text);
+
+/**
+ * @brief Decodes the escapes in string contents (without the quotes) into UTF-8.
+ *
+ * Runs without escapes are copied in bulk. The decoded text is never longer
+ * than the raw text, so out needs room for raw.size() bytes.
+ *
+ * @return The number of bytes written, or std::string_view::npos if an
+ * escape is invalid.
+ */
+size_t unescapeString(std::string_view raw, char* out);
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <core/ParseError.hpp>
+
+#include <expected>
+#include <string_view>
+
+/**
+ * @brief Checks that text is exactly one well-formed JSON value, without
+ * building anything.
+ *
+ * The full RFC 8259 grammar is enforced: string escapes, unescaped control
+ * characters, the number grammar, keywords, and nothing but whitespace after
+ * the value. String contents must also be valid UTF-8. They are scanned 32
+ * bytes at a time with AVX2, multibyte sequences included, and plain ASCII
+ * runs 16 bytes at a time with SSE2.
+ *
+ * Nothing is allocated. Memory use grows only with nesting depth, which is
+ * limited to SaxReader::MaxDepth.
+ *
+ * @return Nothing if the text is valid, otherwise the first error.
+ */
+std::expected<void, ParseError> validate(std::string_view json) noexcept;
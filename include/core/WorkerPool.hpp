@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief A fixed set of worker threads consuming a shared FIFO of tasks.
+ */
+class WorkerPool {
+public:
+    /**
+     * @param threads Number of workers; 0 uses std::thread::hardware_concurrency().
+     */
+    explicit WorkerPool(size_t threads = 0);
+
+    /**
+     * @brief Finishes every queued task, then joins the workers.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    [[nodiscard]] size_t size() const { return workers_.size(); }
+
+    /**
+     * @brief Queues a task.
+     *
+     * @return A future for the task's result. Exceptions thrown by the task are
+     * rethrown by future::get().
+     */
+    template<typename Task>
+    auto submit(Task&& task) -> std::future<std::invoke_result_t<std::decay_t<Task>>> {
+        using Result = std::invoke_result_t<std::decay_t<Task>>;
+
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+        std::future<Result> future = packaged->get_future();
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.emplace_back([packaged] { (*packaged)(); });
+        }
+        queued_.release();
+        return future;
+    }
+
+private:
+    void run();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    // One release per queued task, plus one per worker when stopping.
+    std::counting_semaphore<> queued_{0};
+};
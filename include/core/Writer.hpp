@@ -0,0 +1,116 @@
+#pragma once
+
+#include <core/Document.hpp>
+#include <core/Parser.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct WriteOptions {
+    bool pretty = false; ///< Put every member and element on its own line.
+    int indent = 2; ///< Spaces per nesting level when pretty.
+};
+
+/**
+ * @brief Serializes JSON into a growable buffer, a FILE* or a file descriptor.
+ *
+ * Output is accumulated in an internal buffer. File and descriptor sinks flush
+ * it whenever it grows past FlushThreshold and on destruction. Strings are
+ * escaped with a vectorized scan that copies clean runs in bulk, and doubles
+ * use the shortest text that reads back to the same value.
+ *
+ * JsonWriter is also a JsonHandler, so parse events can be re-emitted without
+ * building a tree: parseEvents(json, writer). Several top-level values are
+ * separated by newlines.
+ */
+class JsonWriter {
+public:
+    static constexpr size_t FlushThreshold = 64 * 1024;
+
+    /**
+     * @brief Writes into an internal buffer, read back with str() or take().
+     */
+    explicit JsonWriter(WriteOptions options = {});
+
+    /**
+     * @brief Writes to a stdio stream. The stream is not closed.
+     */
+    static JsonWriter toFile(std::FILE* file, WriteOptions options = {});
+
+    /**
+     * @brief Writes to a file descriptor. The descriptor is not closed.
+     */
+    static JsonWriter toDescriptor(int fd, WriteOptions options = {});
+
+    ~JsonWriter();
+
+    JsonWriter(JsonWriter&& other) noexcept;
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    void write(const JsonValue& value);
+    void write(ValueRef value);
+
+    bool onStartObject();
+    bool onKey(std::string_view key);
+    bool onEndObject();
+    bool onStartArray();
+    bool onEndArray();
+    bool onString(std::string_view value);
+
+    /**
+     * @brief Writes number text as is; it must already be valid JSON.
+     */
+    bool onNumber(std::string_view text);
+    bool onBoolean(bool value);
+    bool onNull();
+
+    void writeNumber(int64_t value);
+    void writeNumber(uint64_t value);
+
+    /**
+     * @brief Writes a double. NaN and infinities have no JSON form and are written as null.
+     */
+    void writeNumber(double value);
+
+    /**
+     * @brief Hands buffered output to the file or descriptor sink.
+     *
+     * @throws std::runtime_error if the sink reports an error.
+     */
+    void flush();
+
+    [[nodiscard]] const std::string& str() const { return buffer_; }
+    std::string take();
+
+private:
+    enum class Sink {
+        Buffer,
+        File,
+        Descriptor
+    };
+
+    JsonWriter(Sink sink, std::FILE* file, int fd, WriteOptions options);
+
+    void beforeValue();
+    void newline();
+    void writeString(std::string_view value);
+    void maybeFlush();
+
+    Sink sink_;
+    std::FILE* file_{};
+    int fd_{-1};
+    WriteOptions options_;
+    std::string buffer_;
+    std::vector<bool> first_; ///< Per open container: nothing written into it yet.
+    bool afterKey_{};
+    bool wroteRoot_{};
+};
+
+/**
+ * @brief Serializes a value to a string.
+ */
+std::string toJson(const JsonValue& value, const WriteOptions& options = {});
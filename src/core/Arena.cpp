@@ -0,0 +1,78 @@
+#include <core/Arena.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+Arena::Arena(const size_t initialBlockSize) : nextBlockSize_(std::max<size_t>(initialBlockSize, 256)) {
+}
+
+Arena::~Arena() {
+    release();
+}
+
+const char* Arena::copy(const char* data, const size_t size) {
+    if (size == 0) {
+        return "";
+    }
+    auto* target = static_cast<char*>(allocate(size, 1));
+    std::memcpy(target, data, size);
+    return target;
+}
+
+void Arena::release() {
+    while (head_ != nullptr) {
+        Block* next = head_->next;
+        ::operator delete(head_);
+        head_ = next;
+    }
+    cursor_ = nullptr;
+    end_ = nullptr;
+    bytesUsed_ = 0;
+}
+
+void Arena::reset() {
+    if (head_ == nullptr) {
+        return;
+    }
+    if (head_->next != nullptr) {
+        size_t total = 0;
+        for (const Block* block = head_; block != nullptr; block = block->next) {
+            total += block->size;
+        }
+        release();
+        nextBlockSize_ = total;
+        return;
+    }
+
+    cursor_ = reinterpret_cast<char*>(head_ + 1);
+    bytesUsed_ = 0;
+}
+
+void* Arena::do_allocate(const size_t bytes, const size_t alignment) {
+    auto aligned = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(uintptr_t{alignment} - 1);
+    if (cursor_ == nullptr || aligned + bytes > reinterpret_cast<uintptr_t>(end_)) {
+        grow(bytes + alignment);
+        aligned = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(uintptr_t{alignment} - 1);
+    }
+
+    cursor_ = reinterpret_cast<char*>(aligned + bytes);
+    bytesUsed_ += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+bool Arena::do_is_equal(const memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void Arena::grow(const size_t minimumSize) {
+    const size_t size = std::max(nextBlockSize_, minimumSize + sizeof(Block));
+    auto* block = static_cast<Block*>(::operator new(size));
+    block->next = head_;
+    block->size = size;
+    head_ = block;
+
+    cursor_ = reinterpret_cast<char*>(block + 1);
+    end_ = reinterpret_cast<char*>(block) + size;
+    nextBlockSize_ = std::min<size_t>(nextBlockSize_ * 2, 64 * 1024 * 1024);
+}
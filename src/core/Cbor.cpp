@@ -0,0 +1,390 @@
+#include <core/Cbor.hpp>
+#include <core/MappedFile.hpp>
+#include <core/Sax.hpp>
+#include <core/Utf8.hpp>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    enum Major : uint8_t {
+        Unsigned = 0,
+        Negative = 1,
+        Bytes = 2,
+        Text = 3,
+        Array = 4,
+        Map = 5,
+        Tag = 6,
+        Simple = 7
+    };
+
+    constexpr uint8_t False = 0xf4;
+    constexpr uint8_t True = 0xf5;
+    constexpr uint8_t Null = 0xf6;
+    constexpr uint8_t Float16 = 0xf9;
+    constexpr uint8_t Float32 = 0xfa;
+    constexpr uint8_t Float64 = 0xfb;
+    constexpr uint8_t Break = 0xff;
+    constexpr uint8_t Indefinite = 31;
+
+    template<typename T>
+    void appendBigEndian(std::string& out, const T value) {
+        const T big = std::endian::native == std::endian::little ? std::byteswap(value) : value;
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &big, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    /**
+     * Writes an item head with the shortest argument that holds the value.
+     */
+    void appendHead(std::string& out, const Major major, const uint64_t value) {
+        const auto type = static_cast<uint8_t>(major << 5);
+        if (value < 24) {
+            out += static_cast<char>(type | value);
+        } else if (value <= std::numeric_limits<uint8_t>::max()) {
+            out += static_cast<char>(type | 24);
+            out += static_cast<char>(value);
+        } else if (value <= std::numeric_limits<uint16_t>::max()) {
+            out += static_cast<char>(type | 25);
+            appendBigEndian(out, static_cast<uint16_t>(value));
+        } else if (value <= std::numeric_limits<uint32_t>::max()) {
+            out += static_cast<char>(type | 26);
+            appendBigEndian(out, static_cast<uint32_t>(value));
+        } else {
+            out += static_cast<char>(type | 27);
+            appendBigEndian(out, value);
+        }
+    }
+
+    void appendString(std::string& out, const std::string_view text) {
+        appendHead(out, Text, text.size());
+        out.append(text);
+    }
+
+    void appendDouble(std::string& out, const double value) {
+        if (const auto single = static_cast<float>(value); static_cast<double>(single) == value || std::isnan(value)) {
+            out += static_cast<char>(Float32);
+            appendBigEndian(out, std::bit_cast<uint32_t>(single));
+        } else {
+            out += static_cast<char>(Float64);
+            appendBigEndian(out, std::bit_cast<uint64_t>(value));
+        }
+    }
+
+    double halfToDouble(const uint16_t half) {
+        const int exponent = half >> 10 & 0x1f;
+        const int mantissa = half & 0x3ff;
+        double value;
+        if (exponent == 0) {
+            value = std::ldexp(mantissa, -24);
+        } else if (exponent != 31) {
+            value = std::ldexp(mantissa + 1024, exponent - 25);
+        } else {
+            value = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+        }
+        return half & 0x8000 ? -value : value;
+    }
+
+    /**
+     * Decodes one data item at a time by recursive descent.
+     */
+    class CborReader {
+    public:
+        explicit CborReader(const std::string_view bytes) : bytes_(bytes) {
+        }
+
+        std::shared_ptr<JsonValue> document() {
+            auto root = std::make_shared<JsonValue>(value());
+            if (pos_ != bytes_.size()) {
+                fail("unexpected data after the value");
+            }
+            return root;
+        }
+
+    private:
+        [[noreturn]] void fail(const std::string& reason) const {
+            throw std::runtime_error("Invalid CBOR at offset " + std::to_string(pos_) + ": " + reason);
+        }
+
+        void require(const size_t count) const {
+            if (bytes_.size() - pos_ < count) {
+                fail("unexpected end of data");
+            }
+        }
+
+        uint8_t byte() {
+            require(1);
+            return static_cast<uint8_t>(bytes_[pos_++]);
+        }
+
+        template<typename T>
+        T bigEndian() {
+            require(sizeof(T));
+            T value;
+            std::memcpy(&value, bytes_.data() + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return std::endian::native == std::endian::little ? std::byteswap(value) : value;
+        }
+
+        /**
+         * The argument of a head with the given additional information.
+         */
+        uint64_t argument(const uint8_t info) {
+            switch (info) {
+                case 24: return byte();
+                case 25: return bigEndian<uint16_t>();
+                case 26: return bigEndian<uint32_t>();
+                case 27: return bigEndian<uint64_t>();
+                default:
+                    if (info >= 24) {
+                        fail("reserved additional information");
+                    }
+                    return info;
+            }
+        }
+
+        /**
+         * A container count, capped for reserving by what the remaining
+         * bytes could hold so that a bogus count cannot exhaust memory.
+         */
+        [[nodiscard]] size_t reservable(const uint64_t count) const {
+            return static_cast<size_t>(std::min<uint64_t>(count, bytes_.size() - pos_));
+        }
+
+        bool atBreak() {
+            require(1);
+            if (static_cast<uint8_t>(bytes_[pos_]) != Break) {
+                return false;
+            }
+            ++pos_;
+            return true;
+        }
+
+        JsonValue::ValueType value() {
+            size_t start = pos_;
+            uint8_t initial = byte();
+            // Tags are ignored, and skipping a run of them here rather than
+            // recursing keeps a long run from overflowing the stack.
+            while (initial >> 5 == Tag) {
+                argument(initial & 0x1f);
+                start = pos_;
+                initial = byte();
+            }
+            const auto major = static_cast<Major>(initial >> 5);
+            const uint8_t info = initial & 0x1f;
+
+            switch (major) {
+                case Unsigned: {
+                    const uint64_t value = argument(info);
+                    if (value <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                        return static_cast<int64_t>(value);
+                    }
+                    return value;
+                }
+                case Negative: {
+                    const uint64_t value = argument(info);
+                    if (value <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                        return -1 - static_cast<int64_t>(value);
+                    }
+                    // Below INT64_MIN, where JSON text would also become a double.
+                    return -1.0 - static_cast<double>(value);
+                }
+                case Text:
+                    return text(info);
+                case Array:
+                    return array(info);
+                case Map:
+                    return map(info);
+                case Tag:
+                    std::unreachable();
+                case Simple:
+                    return simple(initial);
+                case Bytes:
+                    break;
+            }
+            pos_ = start;
+            fail("byte strings are not supported");
+        }
+
+        std::string text(const uint8_t info) {
+            if (info != Indefinite) {
+                const uint64_t length = argument(info);
+                require(length);
+                std::string result(bytes_.substr(pos_, length));
+                checkUtf8(result);
+                pos_ += length;
+                return result;
+            }
+
+            std::string result;
+            while (!atBreak()) {
+                const uint8_t initial = byte();
+                if (initial >> 5 != Text || (initial & 0x1f) == Indefinite) {
+                    --pos_;
+                    fail("expected a definite-length text chunk");
+                }
+                result += text(initial & 0x1f);
+            }
+            return result;
+        }
+
+        void checkUtf8(const std::string_view text) {
+            for (size_t i = 0; i < text.size();) {
+                i += stringContentPrefix(text.substr(i));
+                if (i == text.size()) {
+                    break;
+                }
+                // Quotes, backslashes and control characters stop the scan
+                // but are fine in CBOR; anything else stopping it is invalid.
+                if (static_cast<unsigned char>(text[i]) < 0x80) {
+                    ++i;
+                } else {
+                    pos_ += i;
+                    fail("invalid UTF-8 in text string");
+                }
+            }
+        }
+
+        JsonArray array(const uint8_t info) {
+            const DepthGuard guard(*this);
+            JsonArray array;
+            if (info == Indefinite) {
+                while (!atBreak()) {
+                    array.push_back(std::make_shared<JsonValue>(value()));
+                }
+                return array;
+            }
+
+            const uint64_t count = argument(info);
+            array.reserve(reservable(count));
+            for (uint64_t i = 0; i < count; ++i) {
+                array.push_back(std::make_shared<JsonValue>(value()));
+            }
+            return array;
+        }
+
+        JsonObject map(const uint8_t info) {
+            const DepthGuard guard(*this);
+            JsonObject object;
+            if (info == Indefinite) {
+                while (!atBreak()) {
+                    member(object);
+                }
+                return object;
+            }
+
+            const uint64_t count = argument(info);
+            object.reserve(reservable(count));
+            for (uint64_t i = 0; i < count; ++i) {
+                member(object);
+            }
+            return object;
+        }
+
+        void member(JsonObject& object) {
+            const uint8_t initial = byte();
+            if (initial >> 5 != Text) {
+                --pos_;
+                fail("map keys must be text strings");
+            }
+            std::string key = text(initial & 0x1f);
+            object.emplace(std::move(key), std::make_shared<JsonValue>(value()));
+        }
+
+        JsonValue::ValueType simple(const uint8_t initial) {
+            switch (initial) {
+                case False: return false;
+                case True: return true;
+                case Null: return nullptr;
+                case Float16: return halfToDouble(bigEndian<uint16_t>());
+                case Float32: return static_cast<double>(std::bit_cast<float>(bigEndian<uint32_t>()));
+                case Float64: return std::bit_cast<double>(bigEndian<uint64_t>());
+                default:
+                    --pos_;
+                    fail("unsupported simple value");
+            }
+        }
+
+        struct DepthGuard {
+            explicit DepthGuard(CborReader& reader) : reader_(reader) {
+                if (++reader_.depth_ > SaxReader<NullHandler>::MaxDepth) {
+                    reader_.fail("nesting too deep");
+                }
+            }
+            ~DepthGuard() { --reader_.depth_; }
+
+            CborReader& reader_;
+        };
+
+        std::string_view bytes_;
+        size_t pos_{};
+        size_t depth_{};
+    };
+
+    void encode(const JsonValue& value, std::string& out) {
+        std::visit([&](const auto& content) {
+            using T = std::decay_t<decltype(content)>;
+            if constexpr (std::is_same_v<T, JsonObject>) {
+                appendHead(out, Map, content.size());
+                for (const auto& [key, member]: content) {
+                    appendString(out, key);
+                    encode(*member, out);
+                }
+            } else if constexpr (std::is_same_v<T, JsonArray>) {
+                appendHead(out, Array, content.size());
+                for (const auto& element: content) {
+                    encode(*element, out);
+                }
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                appendString(out, content);
+            } else if constexpr (std::is_same_v<T, double>) {
+                appendDouble(out, content);
+            } else if constexpr (std::is_same_v<T, bool>) {
+                out += static_cast<char>(content ? True : False);
+            } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                out += static_cast<char>(Null);
+            } else if constexpr (std::is_same_v<T, int64_t>) {
+                if (content >= 0) {
+                    appendHead(out, Unsigned, static_cast<uint64_t>(content));
+                } else {
+                    // -1 - content cannot overflow, unlike -content.
+                    appendHead(out, Negative, static_cast<uint64_t>(-1 - content));
+                }
+            } else {
+                appendHead(out, Unsigned, content);
+            }
+        }, value.value());
+    }
+}
+
+std::string encodeCbor(const JsonValue& value) {
+    std::string out;
+    encodeCbor(value, out);
+    return out;
+}
+
+void encodeCbor(const JsonValue& value, std::string& out) {
+    encode(value, out);
+}
+
+std::shared_ptr<JsonValue> decodeCbor(const std::string_view bytes) {
+    return CborReader(bytes).document();
+}
+
+void writeCborFile(const std::string& path, const JsonValue& value) {
+    const std::string bytes = encodeCbor(value);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.write(bytes.data(), static_cast<std::streamsize>(bytes.size())) || !file.flush()) {
+        throw std::runtime_error("Could not write file: " + path);
+    }
+}
+
+std::shared_ptr<JsonValue> readCborFile(const std::string& path) {
+    const MappedFile file(path);
+    return decodeCbor(file.view());
+}
@@ -0,0 +1,441 @@
+#include <core/Document.hpp>
+#include <core/MappedFile.hpp>
+#include <core/Number.hpp>
+#include <core/Sax.hpp>
+#include <limits>
+#include <new>
+#include <optional>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    const char* typeName(const DomType type) {
+        switch (type) {
+            case DomType::Object: return "object";
+            case DomType::Array: return "array";
+            case DomType::String: return "string";
+            case DomType::Number: return "number";
+            case DomType::Boolean: return "boolean";
+            case DomType::Null: return "null";
+        }
+        return "unknown";
+    }
+
+    template<typename T>
+    const T* copyToArena(Arena& arena, const T* data, const size_t count) {
+        if (count == 0) {
+            return nullptr;
+        }
+        auto* target = static_cast<T*>(arena.allocate(count * sizeof(T), alignof(T)));
+        std::uninitialized_copy_n(data, count, target);
+        return target;
+    }
+
+    DomNode makeNumber(const JsonNumber number) {
+        DomNode node;
+        node.type = DomType::Number;
+        if (const auto* integer = std::get_if<int64_t>(&number)) {
+            node.numberType = NumberType::Int64;
+            node.integer = *integer;
+        } else if (const auto* unsignedInteger = std::get_if<uint64_t>(&number)) {
+            node.numberType = NumberType::UInt64;
+            node.unsignedInteger = *unsignedInteger;
+        } else {
+            node.number = std::get<double>(number);
+        }
+        return node;
+    }
+
+    DomNode makeString(Arena& arena, const std::string_view text) {
+        DomNode node;
+        node.type = DomType::String;
+        node.size = text.size();
+        node.string = arena.copy(text.data(), text.size());
+        return node;
+    }
+
+    /**
+     * Returns the shared pool's copy of a key if it has one, so that pointer
+     * comparison works for every key of a document.
+     */
+    const InternedKey* internKey(KeyInterner& keys, const KeyInterner* sharedKeys, const std::string_view key) {
+        const size_t hash = KeyInterner::hash(key);
+        if (sharedKeys != nullptr) {
+            if (const InternedKey* shared = sharedKeys->find(key, hash)) {
+                return shared;
+            }
+        }
+        return keys.intern(key, hash);
+    }
+
+    /**
+     * A JsonHandler that writes nodes straight into the arena. Children of
+     * the containers being built are collected on scratch stacks and copied
+     * into the arena as one contiguous run when their container closes.
+     */
+    class DocumentBuilder {
+    public:
+        DocumentBuilder(Arena& arena, KeyInterner& keys, const KeyInterner* sharedKeys)
+            : arena_(arena), keys_(keys), sharedKeys_(sharedKeys) {
+        }
+
+        bool onStartObject() {
+            frames_.push_back(Frame{DomType::Object, members_.size(), key_});
+            return true;
+        }
+
+        bool onKey(const std::string_view key) {
+            key_ = internKey(keys_, sharedKeys_, key);
+            return true;
+        }
+
+        bool onEndObject() {
+            const Frame frame = frames_.back();
+            frames_.pop_back();
+
+            DomNode node;
+            node.type = DomType::Object;
+            node.size = members_.size() - frame.mark;
+            node.members = copyToArena(arena_, members_.data() + frame.mark, node.size);
+            members_.resize(frame.mark);
+
+            key_ = frame.key;
+            return add(node);
+        }
+
+        bool onStartArray() {
+            frames_.push_back(Frame{DomType::Array, elements_.size(), key_});
+            return true;
+        }
+
+        bool onEndArray() {
+            const Frame frame = frames_.back();
+            frames_.pop_back();
+
+            DomNode node;
+            node.type = DomType::Array;
+            node.size = elements_.size() - frame.mark;
+            node.elements = copyToArena(arena_, elements_.data() + frame.mark, node.size);
+            elements_.resize(frame.mark);
+
+            key_ = frame.key;
+            return add(node);
+        }
+
+        bool onString(const std::string_view value) {
+            return add(makeString(arena_, value));
+        }
+
+        bool onNumber(const std::string_view text) {
+            const std::optional<JsonNumber> number = tryParseJsonNumber(text);
+            if (!number) {
+                numberOutOfRange_ = text.data();
+                return false;
+            }
+            return add(makeNumber(*number));
+        }
+
+        bool onBoolean(const bool value) {
+            DomNode node;
+            node.type = DomType::Boolean;
+            node.boolean = value;
+            return add(node);
+        }
+
+        bool onNull() {
+            return add(DomNode{});
+        }
+
+        [[nodiscard]] const DomNode& root() const { return root_; }
+
+        /**
+         * Where the number that stopped the parse starts, or nullptr.
+         */
+        [[nodiscard]] const char* numberOutOfRange() const { return numberOutOfRange_; }
+
+    private:
+        struct Frame {
+            DomType type;
+            size_t mark;
+            const InternedKey* key; ///< The key this container will be stored under.
+        };
+
+        bool add(const DomNode& node) {
+            if (frames_.empty()) {
+                root_ = node;
+            } else if (frames_.back().type == DomType::Object) {
+                members_.push_back(DomMember{key_, node});
+            } else {
+                elements_.push_back(node);
+            }
+            return true;
+        }
+
+        Arena& arena_;
+        KeyInterner& keys_;
+        const KeyInterner* sharedKeys_;
+        std::vector<Frame> frames_;
+        std::vector<DomNode> elements_;
+        std::vector<DomMember> members_;
+        const InternedKey* key_{};
+        DomNode root_;
+        const char* numberOutOfRange_{};
+    };
+
+    DomNode convert(const JsonValue& value, Arena& arena, KeyInterner& keys) {
+        return std::visit(
+            [&]<typename T0>(const T0& val) {
+                using T = std::decay_t<T0>;
+
+                DomNode node;
+                if constexpr (std::is_same_v<T, JsonObject>) {
+                    std::vector<DomMember> members;
+                    members.reserve(val.size());
+                    for (const auto& [key, objVal]: val) {
+                        members.push_back(DomMember{keys.intern(key), convert(*objVal, arena, keys)});
+                    }
+                    node.type = DomType::Object;
+                    node.size = members.size();
+                    node.members = copyToArena(arena, members.data(), members.size());
+                } else if constexpr (std::is_same_v<T, JsonArray>) {
+                    std::vector<DomNode> elements;
+                    elements.reserve(val.size());
+                    for (const auto& arrVal: val) {
+                        elements.push_back(convert(*arrVal, arena, keys));
+                    }
+                    node.type = DomType::Array;
+                    node.size = elements.size();
+                    node.elements = copyToArena(arena, elements.data(), elements.size());
+                } else if constexpr (std::is_same_v<T, std::string>) {
+                    node = makeString(arena, val);
+                } else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>) {
+                    node = makeNumber(val);
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    node.type = DomType::Boolean;
+                    node.boolean = val;
+                }
+                return node;
+            },
+            value.value());
+    }
+}
+
+DomType ValueRef::type() const {
+    if (node_ == nullptr) {
+        throw std::runtime_error("Empty value reference");
+    }
+    return node_->type;
+}
+
+const DomNode& ValueRef::node(const DomType expected) const {
+    if (const DomType actual = type(); actual != expected) {
+        throw std::runtime_error(std::string("Expected ") + typeName(expected) + ", got: " + typeName(actual));
+    }
+    return *node_;
+}
+
+std::string_view ValueRef::asString() const {
+    const DomNode& n = node(DomType::String);
+    return {n.string, n.size};
+}
+
+double ValueRef::asNumber() const {
+    const DomNode& n = node(DomType::Number);
+    switch (n.numberType) {
+        case NumberType::Int64: return static_cast<double>(n.integer);
+        case NumberType::UInt64: return static_cast<double>(n.unsignedInteger);
+        case NumberType::Double: break;
+    }
+    return n.number;
+}
+
+int64_t ValueRef::asInt64() const {
+    const DomNode& n = node(DomType::Number);
+    if (n.numberType == NumberType::Int64) {
+        return n.integer;
+    }
+    throw std::runtime_error("Number is not a 64-bit signed integer");
+}
+
+uint64_t ValueRef::asUInt64() const {
+    const DomNode& n = node(DomType::Number);
+    if (n.numberType == NumberType::UInt64) {
+        return n.unsignedInteger;
+    }
+    if (n.numberType == NumberType::Int64 && n.integer >= 0) {
+        return static_cast<uint64_t>(n.integer);
+    }
+    throw std::runtime_error("Number is not a 64-bit unsigned integer");
+}
+
+NumberType ValueRef::numberType() const {
+    return node(DomType::Number).numberType;
+}
+
+bool ValueRef::asBoolean() const {
+    return node(DomType::Boolean).boolean;
+}
+
+size_t ValueRef::size() const {
+    if (const DomType actual = type(); actual != DomType::Object && actual != DomType::Array) {
+        throw std::runtime_error(std::string("Expected object or array, got: ") + typeName(actual));
+    }
+    return node_->size;
+}
+
+std::span<const DomNode> ValueRef::elements() const {
+    const DomNode& n = node(DomType::Array);
+    return {n.elements, n.size};
+}
+
+std::span<const DomMember> ValueRef::members() const {
+    const DomNode& n = node(DomType::Object);
+    return {n.members, n.size};
+}
+
+ValueRef ValueRef::operator[](const size_t index) const {
+    const auto items = elements();
+    if (index >= items.size()) {
+        throw std::runtime_error("Array index out of range: " + std::to_string(index));
+    }
+    return items[index];
+}
+
+ValueRef ValueRef::operator[](const std::string_view key) const {
+    const ValueRef value = find(key);
+    if (!value) {
+        throw std::runtime_error("Key not found: " + std::string(key));
+    }
+    return value;
+}
+
+ValueRef ValueRef::find(const std::string_view key) const {
+    const size_t hash = KeyInterner::hash(key);
+    for (const DomMember& member: members()) {
+        if (member.name->hash == hash && member.key() == key) {
+            return member.value;
+        }
+    }
+    return {};
+}
+
+ValueRef ValueRef::find(const InternedKey* key) const {
+    for (const DomMember& member: members()) {
+        if (member.name == key) {
+            return member.value;
+        }
+    }
+    return {};
+}
+
+Document::Document() : arena_(std::make_unique<Arena>()), keys_(std::make_unique<KeyInterner>(*arena_)) {
+}
+
+Document Document::parse(const std::string_view json) {
+    return parse(json, nullptr);
+}
+
+Document Document::parse(const std::string_view json, const KeyInterner& sharedKeys) {
+    return parse(json, &sharedKeys);
+}
+
+Document Document::parse(const std::string_view json, const KeyInterner* sharedKeys) {
+    std::expected<Document, ParseError> document = tryParse(json, sharedKeys);
+    if (!document) {
+        throw ParseException(document.error());
+    }
+    return std::move(*document);
+}
+
+std::expected<Document, ParseError> Document::tryParse(const std::string_view json) noexcept {
+    return tryParse(json, nullptr);
+}
+
+std::expected<Document, ParseError> Document::tryParse(const std::string_view json, const KeyInterner& sharedKeys) noexcept {
+    return tryParse(json, &sharedKeys);
+}
+
+std::expected<Document, ParseError> Document::tryParse(const std::string_view json, const KeyInterner* sharedKeys) noexcept {
+    try {
+        Document document;
+        document.sharedKeys_ = sharedKeys;
+        DocumentBuilder builder(*document.arena_, *document.keys_, sharedKeys);
+
+        const std::expected<bool, ParseError> complete = tryParseEvents(json, builder);
+        if (!complete) {
+            return std::unexpected(complete.error());
+        }
+        if (!*complete) {
+            const auto offset = static_cast<size_t>(builder.numberOutOfRange() - json.data());
+            return std::unexpected(ParseError{ParseErrorCode::NumberOutOfRange, 0, 0, offset}.locate(json));
+        }
+
+        document.root_ = copyToArena(*document.arena_, &builder.root(), 1);
+        return document;
+    } catch (const std::bad_alloc&) {
+        return std::unexpected(ParseError{ParseErrorCode::OutOfMemory});
+    }
+}
+
+Document Document::parseFile(const std::string& path) {
+    const MappedFile file(path);
+    return parse(file.view());
+}
+
+Document Document::fromJsonValue(const JsonValue& value) {
+    Document document;
+    const DomNode root = convert(value, *document.arena_, *document.keys_);
+    document.root_ = copyToArena(*document.arena_, &root, 1);
+    return document;
+}
+
+const InternedKey* Document::key(const std::string_view key) const {
+    const size_t hash = KeyInterner::hash(key);
+    if (sharedKeys_ != nullptr) {
+        if (const InternedKey* shared = sharedKeys_->find(key, hash)) {
+            return shared;
+        }
+    }
+    return keys_->find(key, hash);
+}
+
+std::shared_ptr<JsonValue> Document::toJsonValue() const {
+    return ::toJsonValue(root());
+}
+
+std::shared_ptr<JsonValue> toJsonValue(const ValueRef value) {
+    switch (value.type()) {
+        case DomType::Object: {
+            JsonObject object;
+            for (const DomMember& member: value.members()) {
+                object.emplace(std::string(member.key()), toJsonValue(member.value));
+            }
+            return std::make_shared<JsonValue>(std::move(object));
+        }
+        case DomType::Array: {
+            JsonArray array;
+            array.reserve(value.size());
+            for (const DomNode& element: value.elements()) {
+                array.push_back(toJsonValue(element));
+            }
+            return std::make_shared<JsonValue>(std::move(array));
+        }
+        case DomType::String:
+            return std::make_shared<JsonValue>(std::string(value.asString()));
+        case DomType::Number:
+            switch (value.numberType()) {
+                case NumberType::Int64: return std::make_shared<JsonValue>(value.asInt64());
+                case NumberType::UInt64: return std::make_shared<JsonValue>(value.asUInt64());
+                case NumberType::Double: break;
+            }
+            return std::make_shared<JsonValue>(value.asNumber());
+        case DomType::Boolean:
+            return std::make_shared<JsonValue>(value.asBoolean());
+        case DomType::Null:
+            break;
+    }
+    return std::make_shared<JsonValue>(nullptr);
+}
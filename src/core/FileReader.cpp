@@ -1,6 +1,5 @@
 #include <core/FileReader.hpp>
 #include <fstream>
-#include <sstream>
 #include <stdexcept>
 #include <filesystem>
 
@@ -15,12 +14,15 @@ std::string FileReader::read(const std::string& path) {
         throw std::runtime_error("Path is not a regular file: " + path);
     }
 
-    std::ifstream file(path);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open file: " + path);
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
+    std::string contents(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(contents.data(), static_cast<std::streamsize>(contents.size()))) {
+        throw std::runtime_error("Failed to read file: " + path);
+    }
+    return contents;
 }
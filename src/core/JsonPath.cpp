@@ -0,0 +1,794 @@
+#include <core/JsonPath.hpp>
+#include <core/Number.hpp>
+#include <core/Sax.hpp>
+#include <core/Utf8.hpp>
+#include <bit>
+#include <charconv>
+#include <stdexcept>
+
+namespace {
+    /**
+     * A value as filters compare it. Nothing (a query that found no value)
+     * is monostate; containers are compared by identity.
+     */
+    using Comparable = std::variant<std::monostate, std::nullptr_t, bool, double, std::string_view, const JsonValue*>;
+
+    Comparable comparable(const JsonValue* value) {
+        if (value == nullptr) {
+            return {};
+        }
+        return std::visit([&](const auto& content) -> Comparable {
+            using T = std::decay_t<decltype(content)>;
+            if constexpr (std::is_same_v<T, JsonObject> || std::is_same_v<T, JsonArray>) {
+                return value;
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                return std::string_view(content);
+            } else if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>) {
+                return static_cast<double>(content);
+            } else {
+                return content;
+            }
+        }, value->value());
+    }
+
+    Comparable comparable(const std::variant<std::nullptr_t, bool, double, std::string>& literal) {
+        return std::visit([](const auto& content) -> Comparable {
+            if constexpr (std::is_same_v<std::decay_t<decltype(content)>, std::string>) {
+                return std::string_view(content);
+            } else {
+                return content;
+            }
+        }, literal);
+    }
+
+    bool less(const Comparable& left, const Comparable& right) {
+        if (const auto* a = std::get_if<double>(&left), * b = std::get_if<double>(&right); a && b) {
+            return *a < *b;
+        }
+        if (const auto* a = std::get_if<std::string_view>(&left), * b = std::get_if<std::string_view>(&right); a && b) {
+            return *a < *b;
+        }
+        return false;
+    }
+
+    bool isSpace(const char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    bool isNameStart(const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+    }
+
+    bool isNameChar(const char c) {
+        return isNameStart(c) || (c >= '0' && c <= '9');
+    }
+}
+
+/**
+ * Parses an expression into the steps of a JsonPath.
+ */
+class JsonPathCompiler {
+public:
+    explicit JsonPathCompiler(const std::string_view text) : text_(text) {
+    }
+
+    JsonPath compile() {
+        JsonPath path;
+        path.expression_ = text_;
+        expect('$');
+
+        while (pos_ < text_.size()) {
+            JsonPath::Step step;
+            if (consume("..")) {
+                step.descendant = true;
+                step.selectors = peek() == '[' ? brackets() : shorthand();
+            } else if (consume('.')) {
+                step.selectors = shorthand();
+            } else if (peek() == '[') {
+                step.selectors = brackets();
+            } else {
+                fail("expected '.', '..' or '['");
+            }
+
+            if (path.steps_.size() == JsonPath::MaxSteps) {
+                fail("too many steps");
+            }
+            for (const JsonPath::Selector& selector: step.selectors) {
+                if (selector.kind == JsonPath::Selector::Kind::Filter) {
+                    path.filterMask_ |= JsonPath::States{1} << path.steps_.size();
+                }
+            }
+            path.steps_.push_back(std::move(step));
+        }
+        return path;
+    }
+
+private:
+    using Selector = JsonPath::Selector;
+    using Filter = JsonPath::Filter;
+    using FilterOp = JsonPath::FilterOp;
+    using FilterOperand = JsonPath::FilterOperand;
+
+    [[noreturn]] void fail(const std::string& reason) const {
+        throw std::runtime_error("Invalid JSONPath at offset " + std::to_string(pos_) + ": " + reason);
+    }
+
+    [[nodiscard]] char peek() const { return pos_ < text_.size() ? text_[pos_] : '\0'; }
+
+    bool consume(const char c) {
+        if (peek() != c) {
+            return false;
+        }
+        ++pos_;
+        return true;
+    }
+
+    bool consume(const std::string_view token) {
+        if (text_.substr(pos_, token.size()) != token) {
+            return false;
+        }
+        pos_ += token.size();
+        return true;
+    }
+
+    void expect(const char c) {
+        if (!consume(c)) {
+            fail(std::string("expected '") + c + "'");
+        }
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && isSpace(text_[pos_])) {
+            ++pos_;
+        }
+    }
+
+    /**
+     * A `*` or member name after a dot.
+     */
+    std::vector<Selector> shorthand() {
+        Selector selector;
+        if (consume('*')) {
+            selector.kind = Selector::Kind::Wildcard;
+        } else {
+            selector.kind = Selector::Kind::Name;
+            selector.name = name();
+        }
+        return {std::move(selector)};
+    }
+
+    std::string name() {
+        if (!isNameStart(peek())) {
+            fail("expected a member name");
+        }
+        const size_t start = pos_;
+        while (pos_ < text_.size() && isNameChar(text_[pos_])) {
+            ++pos_;
+        }
+        return std::string(text_.substr(start, pos_ - start));
+    }
+
+    std::vector<Selector> brackets() {
+        expect('[');
+        std::vector<Selector> selectors;
+        do {
+            skipSpace();
+            selectors.push_back(selector());
+            skipSpace();
+        } while (consume(','));
+        expect(']');
+        return selectors;
+    }
+
+    Selector selector() {
+        Selector selector;
+        if (const char c = peek(); c == '\'' || c == '"') {
+            selector.kind = Selector::Kind::Name;
+            selector.name = quoted();
+        } else if (consume('*')) {
+            selector.kind = Selector::Kind::Wildcard;
+        } else if (consume('?')) {
+            selector.kind = Selector::Kind::Filter;
+            skipSpace();
+            selector.filter = disjunction();
+        } else {
+            const std::optional<size_t> start = position();
+            skipSpace();
+            if (!consume(':')) {
+                if (!start) {
+                    fail("expected a selector");
+                }
+                selector.kind = Selector::Kind::Index;
+                selector.index = *start;
+                return selector;
+            }
+
+            selector.kind = Selector::Kind::Slice;
+            selector.slice.start = start.value_or(0);
+            skipSpace();
+            selector.slice.end = position().value_or(SIZE_MAX);
+            skipSpace();
+            if (consume(':')) {
+                skipSpace();
+                selector.slice.step = position().value_or(1);
+                if (selector.slice.step == 0) {
+                    fail("slice step must be positive");
+                }
+            }
+        }
+        return selector;
+    }
+
+    /**
+     * A non-negative array position, or nullopt if there is no number here.
+     */
+    std::optional<size_t> position() {
+        if (peek() != '-' && (peek() < '0' || peek() > '9')) {
+            return std::nullopt;
+        }
+        const int64_t value = integer();
+        if (value < 0) {
+            fail("negative indices are only supported inside filters");
+        }
+        return static_cast<size_t>(value);
+    }
+
+    int64_t integer() {
+        int64_t value{};
+        const auto [end, error] = std::from_chars(text_.data() + pos_, text_.data() + text_.size(), value);
+        if (error != std::errc()) {
+            fail("expected an integer");
+        }
+        pos_ = static_cast<size_t>(end - text_.data());
+        return value;
+    }
+
+    /**
+     * A string in single or double quotes, with JSON escapes and \'.
+     */
+    std::string quoted() {
+        const char quote = text_[pos_++];
+        std::string result;
+        while (true) {
+            if (pos_ >= text_.size()) {
+                fail("unterminated string");
+            }
+            const char c = text_[pos_];
+            if (c == quote) {
+                ++pos_;
+                return result;
+            }
+            if (c != '\\') {
+                result += c;
+                ++pos_;
+                continue;
+            }
+
+            if (text_.substr(pos_, 2) == "\\'") {
+                result += '\'';
+                pos_ += 2;
+                continue;
+            }
+            const size_t length = escapeLength(text_.substr(pos_));
+            if (length == 0) {
+                fail("invalid escape");
+            }
+            char decoded[4];
+            result.append(decoded, unescapeString(text_.substr(pos_, length), decoded));
+            pos_ += length;
+        }
+    }
+
+    Filter disjunction() {
+        Filter filter = conjunction();
+        while (skipSpace(), consume("||")) {
+            skipSpace();
+            filter = combine(FilterOp::Or, std::move(filter), conjunction());
+        }
+        return filter;
+    }
+
+    Filter conjunction() {
+        Filter filter = negation();
+        while (skipSpace(), consume("&&")) {
+            skipSpace();
+            filter = combine(FilterOp::And, std::move(filter), negation());
+        }
+        return filter;
+    }
+
+    static Filter combine(const FilterOp op, Filter left, Filter right) {
+        Filter filter;
+        filter.op = op;
+        filter.children.push_back(std::move(left));
+        filter.children.push_back(std::move(right));
+        return filter;
+    }
+
+    Filter negation() {
+        if (peek() == '!' && text_.substr(pos_, 2) != "!=") {
+            ++pos_;
+            skipSpace();
+            Filter filter;
+            filter.op = FilterOp::Not;
+            filter.children.push_back(negation());
+            return filter;
+        }
+        if (consume('(')) {
+            skipSpace();
+            Filter filter = disjunction();
+            skipSpace();
+            expect(')');
+            return filter;
+        }
+        return comparison();
+    }
+
+    Filter comparison() {
+        Filter filter;
+        filter.left = operand();
+        skipSpace();
+
+        static constexpr std::pair<std::string_view, FilterOp> operators[] = {
+            {"==", FilterOp::Equal}, {"!=", FilterOp::NotEqual}, {"<=", FilterOp::LessEqual},
+            {">=", FilterOp::GreaterEqual}, {"<", FilterOp::Less}, {">", FilterOp::Greater},
+        };
+        for (const auto& [token, op]: operators) {
+            if (consume(token)) {
+                skipSpace();
+                filter.op = op;
+                filter.right = operand();
+                return filter;
+            }
+        }
+
+        if (!filter.left.isQuery) {
+            fail("expected a comparison operator");
+        }
+        filter.op = FilterOp::Exists;
+        return filter;
+    }
+
+    FilterOperand operand() {
+        FilterOperand operand;
+        if (consume('@')) {
+            operand.isQuery = true;
+            while (true) {
+                JsonPath::QueryKey key;
+                if (consume('.')) {
+                    key.name = name();
+                } else if (peek() == '[') {
+                    ++pos_;
+                    skipSpace();
+                    if (const char c = peek(); c == '\'' || c == '"') {
+                        key.name = quoted();
+                    } else {
+                        key.index = integer();
+                        key.isIndex = true;
+                    }
+                    skipSpace();
+                    expect(']');
+                } else {
+                    return operand;
+                }
+                operand.query.push_back(std::move(key));
+            }
+        }
+
+        if (const char c = peek(); c == '\'' || c == '"') {
+            operand.literal = quoted();
+        } else if (consume("true")) {
+            operand.literal = true;
+        } else if (consume("false")) {
+            operand.literal = false;
+        } else if (consume("null")) {
+            operand.literal = nullptr;
+        } else if (const size_t length = scanNumber(text_.substr(pos_)); length > 0) {
+            const std::optional<JsonNumber> number = tryParseJsonNumber(text_.substr(pos_, length));
+            if (!number) {
+                fail("invalid number");
+            }
+            operand.literal = std::visit([](const auto value) { return static_cast<double>(value); }, *number);
+            pos_ += length;
+        } else {
+            fail("expected '@' or a literal");
+        }
+        return operand;
+    }
+
+    std::string_view text_;
+    size_t pos_{};
+};
+
+/**
+ * A JsonHandler that runs a compiled path over parse events.
+ *
+ * Containers some step can still apply to are tracked with the path states
+ * they are in. Anything else is passive: below a container no step reaches,
+ * events only maintain a depth count, and nothing is built unless the
+ * passive region is a match or a filter candidate. Values are built the way
+ * DomBuilder builds them, and a match nested in another shares its nodes.
+ */
+class JsonPathMatcher {
+public:
+    JsonPathMatcher(const JsonPath& path, std::vector<std::shared_ptr<JsonValue> >& results)
+        : path_(path), results_(results) {
+    }
+
+    bool onStartObject() {
+        startContainer(false);
+        return true;
+    }
+
+    bool onKey(const std::string_view key) {
+        if (passiveDepth_ > 0) {
+            if (passiveBuilds_) {
+                keys_.back() = key;
+            }
+            return true;
+        }
+
+        Frame& frame = frames_.back();
+        frame.childStates = path_.childStates(frame.states, key, 0, false);
+        if (frame.builds) {
+            keys_.back() = key;
+        }
+        return true;
+    }
+
+    bool onEndObject() {
+        endContainer();
+        return true;
+    }
+
+    bool onStartArray() {
+        startContainer(true);
+        return true;
+    }
+
+    bool onEndArray() {
+        endContainer();
+        return true;
+    }
+
+    bool onString(const std::string_view value) {
+        scalar([&] { return JsonValue::ValueType(std::string(value)); });
+        return true;
+    }
+
+    bool onNumber(const std::string_view text) {
+        scalar([&] {
+            return std::visit([](const auto number) { return JsonValue::ValueType(number); }, parseJsonNumber(text));
+        });
+        return true;
+    }
+
+    bool onBoolean(const bool value) {
+        scalar([&] { return JsonValue::ValueType(value); });
+        return true;
+    }
+
+    bool onNull() {
+        scalar([] { return JsonValue::ValueType(nullptr); });
+        return true;
+    }
+
+private:
+    using States = JsonPath::States;
+    static constexpr size_t NoSlot = SIZE_MAX;
+
+    /**
+     * A tracked container.
+     */
+    struct Frame {
+        States states;
+        States childStates; ///< Of the member whose key was seen last.
+        size_t index;       ///< Of the next element.
+        bool isArray;
+        bool builds;
+        size_t slot; ///< Where the container goes in the results, if it is a match.
+    };
+
+    /**
+     * How a value relates to the path, worked out when it starts.
+     */
+    struct Start {
+        States states;       ///< Not counting filters.
+        States parentStates;
+        bool builds;
+        bool deferred;       ///< A filter candidate, tested once built.
+    };
+
+    Start start() {
+        if (frames_.empty()) {
+            const States root = 1;
+            return {root, 0, (root & path_.finalState()) != 0, false};
+        }
+
+        Frame& parent = frames_.back();
+        const States states = parent.isArray ? path_.childStates(parent.states, {}, parent.index++, true)
+                                             : parent.childStates;
+        const bool deferred = (parent.states & path_.filterMask_) != 0;
+        return {states, parent.states, parent.builds || deferred || (states & path_.finalState()) != 0, deferred};
+    }
+
+    void startContainer(const bool isArray) {
+        if (passiveDepth_ > 0) {
+            ++passiveDepth_;
+            if (passiveBuilds_) {
+                push(isArray);
+            }
+            return;
+        }
+
+        const Start value = start();
+        if (value.builds) {
+            push(isArray);
+        }
+
+        size_t slot = NoSlot;
+        if (!value.deferred && (value.states & path_.finalState()) != 0) {
+            // Reserve the place now so that results stay in document order
+            // even though matches nested in this one complete first.
+            slot = results_.size();
+            results_.emplace_back();
+        }
+
+        if (value.deferred || (value.states & (path_.finalState() - 1)) == 0) {
+            passiveDepth_ = 1;
+            passiveBuilds_ = value.builds;
+            region_ = {value, slot};
+        } else {
+            frames_.push_back(Frame{value.states, 0, 0, isArray, value.builds, slot});
+        }
+    }
+
+    void endContainer() {
+        if (passiveDepth_ > 0) {
+            std::shared_ptr<JsonValue> node = passiveBuilds_ ? pop() : nullptr;
+            if (--passiveDepth_ > 0) {
+                if (passiveBuilds_) {
+                    attach(std::move(node));
+                }
+                return;
+            }
+            finish(region_.start, std::move(node), region_.slot);
+            return;
+        }
+
+        const Frame frame = frames_.back();
+        frames_.pop_back();
+        finish({}, frame.builds ? pop() : nullptr, frame.slot);
+    }
+
+    template<typename Make>
+    void scalar(const Make& make) {
+        if (passiveDepth_ > 0) {
+            if (passiveBuilds_) {
+                attach(std::make_shared<JsonValue>(make()));
+            }
+            return;
+        }
+
+        const Start value = start();
+        if (!value.builds) {
+            return;
+        }
+        size_t slot = NoSlot;
+        if (!value.deferred && (value.states & path_.finalState()) != 0) {
+            slot = results_.size();
+            results_.emplace_back();
+        }
+        finish(value, std::make_shared<JsonValue>(make()), slot);
+    }
+
+    /**
+     * Completes a tracked value or the root of a passive region.
+     */
+    void finish(const Start& value, std::shared_ptr<JsonValue> node, const size_t slot) {
+        if (value.deferred) {
+            const States states = value.states | path_.filterStates(value.parentStates, *node);
+            path_.collect(node, states, results_);
+        }
+        if (slot != NoSlot) {
+            results_[slot] = node;
+        }
+        if (!frames_.empty() && frames_.back().builds) {
+            attach(std::move(node));
+        }
+    }
+
+    void push(const bool isArray) {
+        if (isArray) {
+            stack_.emplace_back(JsonArray{});
+        } else {
+            stack_.emplace_back(JsonObject{});
+            keys_.emplace_back();
+        }
+    }
+
+    std::shared_ptr<JsonValue> pop() {
+        if (std::holds_alternative<JsonObject>(stack_.back())) {
+            keys_.pop_back();
+        }
+        auto node = std::make_shared<JsonValue>(std::move(stack_.back()));
+        stack_.pop_back();
+        return node;
+    }
+
+    void attach(std::shared_ptr<JsonValue> node) {
+        if (auto* object = std::get_if<JsonObject>(&stack_.back())) {
+            object->emplace(std::move(keys_.back()), std::move(node));
+        } else {
+            std::get<JsonArray>(stack_.back()).push_back(std::move(node));
+        }
+    }
+
+    /**
+     * The untracked subtree being passed over.
+     */
+    struct Region {
+        Start start;
+        size_t slot;
+    };
+
+    const JsonPath& path_;
+    std::vector<std::shared_ptr<JsonValue> >& results_;
+    std::vector<Frame> frames_;
+    size_t passiveDepth_{};
+    bool passiveBuilds_{};
+    Region region_{};
+    std::vector<JsonValue::ValueType> stack_;
+    std::vector<std::string> keys_;
+};
+
+JsonPath JsonPath::compile(const std::string_view expression) {
+    return JsonPathCompiler(expression).compile();
+}
+
+std::vector<std::shared_ptr<JsonValue> > JsonPath::select(const std::string_view json) const {
+    Tokenizer tokenizer(json);
+    return select(tokenizer);
+}
+
+std::vector<std::shared_ptr<JsonValue> > JsonPath::select(Tokenizer& tokenizer) const {
+    std::vector<std::shared_ptr<JsonValue> > results;
+    JsonPathMatcher matcher(*this, results);
+    if (const std::expected<bool, ParseError> complete = tryParseEvents(tokenizer, matcher); !complete) {
+        throw ParseException(complete.error());
+    }
+    return results;
+}
+
+std::vector<std::shared_ptr<JsonValue> > JsonPath::select(const std::shared_ptr<JsonValue>& root) const {
+    std::vector<std::shared_ptr<JsonValue> > results;
+    if (root) {
+        collect(root, 1, results);
+    }
+    return results;
+}
+
+JsonPath::States JsonPath::childStates(const States parent, const std::string_view key, const size_t index,
+                                       const bool inArray) const {
+    States result = 0;
+    for (States remaining = parent & (finalState() - 1); remaining != 0; remaining &= remaining - 1) {
+        const int k = std::countr_zero(remaining);
+        const Step& step = steps_[k];
+        if (step.descendant) {
+            result |= States{1} << k;
+        }
+        for (const Selector& selector: step.selectors) {
+            bool matches = false;
+            switch (selector.kind) {
+                case Selector::Kind::Name:
+                    matches = !inArray && key == selector.name;
+                    break;
+                case Selector::Kind::Wildcard:
+                    matches = true;
+                    break;
+                case Selector::Kind::Index:
+                    matches = inArray && index == selector.index;
+                    break;
+                case Selector::Kind::Slice:
+                    matches = inArray && index >= selector.slice.start && index < selector.slice.end &&
+                              (index - selector.slice.start) % selector.slice.step == 0;
+                    break;
+                case Selector::Kind::Filter:
+                    break;
+            }
+            if (matches) {
+                result |= States{1} << (k + 1);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+JsonPath::States JsonPath::filterStates(const States parent, const JsonValue& child) const {
+    States result = 0;
+    for (States remaining = parent & filterMask_; remaining != 0; remaining &= remaining - 1) {
+        const int k = std::countr_zero(remaining);
+        for (const Selector& selector: steps_[k].selectors) {
+            if (selector.kind == Selector::Kind::Filter && test(selector.filter, child)) {
+                result |= States{1} << (k + 1);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+bool JsonPath::test(const Filter& filter, const JsonValue& candidate) {
+    const auto resolve = [&](const FilterOperand& operand) -> Comparable {
+        if (!operand.isQuery) {
+            return comparable(operand.literal);
+        }
+
+        const JsonValue* value = &candidate;
+        for (const QueryKey& key: operand.query) {
+            const JsonValue* next = nullptr;
+            if (key.isIndex) {
+                if (const auto* array = std::get_if<JsonArray>(&value->value())) {
+                    const auto size = static_cast<int64_t>(array->size());
+                    if (const int64_t index = key.index < 0 ? size + key.index : key.index; index >= 0 && index < size) {
+                        next = (*array)[static_cast<size_t>(index)].get();
+                    }
+                }
+            } else if (const auto* object = std::get_if<JsonObject>(&value->value())) {
+                if (const auto found = object->find(key.name); found != object->end()) {
+                    next = found->second.get();
+                }
+            }
+            if (next == nullptr) {
+                return {};
+            }
+            value = next;
+        }
+        return comparable(value);
+    };
+
+    switch (filter.op) {
+        case FilterOp::Or: return test(filter.children[0], candidate) || test(filter.children[1], candidate);
+        case FilterOp::And: return test(filter.children[0], candidate) && test(filter.children[1], candidate);
+        case FilterOp::Not: return !test(filter.children[0], candidate);
+        case FilterOp::Exists: return !std::holds_alternative<std::monostate>(resolve(filter.left));
+        default: break;
+    }
+
+    const Comparable left = resolve(filter.left);
+    const Comparable right = resolve(filter.right);
+    switch (filter.op) {
+        case FilterOp::Equal: return left == right;
+        case FilterOp::NotEqual: return left != right;
+        case FilterOp::Less: return less(left, right);
+        case FilterOp::LessEqual: return less(left, right) || left == right;
+        case FilterOp::Greater: return less(right, left);
+        case FilterOp::GreaterEqual: return less(right, left) || left == right;
+        default: return false;
+    }
+}
+
+void JsonPath::collect(const std::shared_ptr<JsonValue>& value, const States states,
+                       std::vector<std::shared_ptr<JsonValue> >& results) const {
+    if ((states & finalState()) != 0) {
+        results.push_back(value);
+    }
+    if ((states & (finalState() - 1)) == 0) {
+        return;
+    }
+
+    if (const auto* object = std::get_if<JsonObject>(&value->value())) {
+        for (const auto& [key, child]: *object) {
+            if (const States next = childStates(states, key, 0, false) | filterStates(states, *child)) {
+                collect(child, next, results);
+            }
+        }
+    } else if (const auto* array = std::get_if<JsonArray>(&value->value())) {
+        for (size_t i = 0; i < array->size(); ++i) {
+            if (const States next = childStates(states, {}, i, true) | filterStates(states, *(*array)[i])) {
+                collect((*array)[i], next, results);
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include <core/KeyInterner.hpp>
+
+namespace {
+    constexpr size_t InitialSlots = 64;
+}
+
+KeyInterner::KeyInterner() : ownedArena_(std::make_unique<Arena>(4096)), arena_(*ownedArena_) {
+    slots_.resize(InitialSlots);
+}
+
+KeyInterner::KeyInterner(Arena& arena) : arena_(arena) {
+    slots_.resize(InitialSlots);
+}
+
+const InternedKey* KeyInterner::find(const std::string_view key, const size_t hash) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        const InternedKey* entry = slots_[slot];
+        if (entry == nullptr) {
+            return nullptr;
+        }
+        if (entry->hash == hash && entry->view() == key) {
+            return entry;
+        }
+    }
+}
+
+const InternedKey* KeyInterner::intern(const std::string_view key, const size_t hash) {
+    const size_t mask = slots_.size() - 1;
+    size_t slot = hash & mask;
+    for (; slots_[slot] != nullptr; slot = (slot + 1) & mask) {
+        if (slots_[slot]->hash == hash && slots_[slot]->view() == key) {
+            return slots_[slot];
+        }
+    }
+
+    auto* entry = static_cast<InternedKey*>(arena_.allocate(sizeof(InternedKey), alignof(InternedKey)));
+    *entry = InternedKey{arena_.copy(key.data(), key.size()), key.size(), hash, static_cast<uint32_t>(keys_.size())};
+    slots_[slot] = entry;
+    keys_.push_back(entry);
+
+    // Keep the table at most half full so probe sequences stay short.
+    if (keys_.size() * 2 > slots_.size()) {
+        rehash();
+    }
+    return entry;
+}
+
+void KeyInterner::rehash() {
+    std::vector<const InternedKey*> slots(slots_.size() * 2);
+    const size_t mask = slots.size() - 1;
+    for (const InternedKey* entry: keys_) {
+        size_t slot = entry->hash & mask;
+        while (slots[slot] != nullptr) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = entry;
+    }
+    slots_ = std::move(slots);
+}
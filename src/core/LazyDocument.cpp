@@ -0,0 +1,311 @@
+#include <core/LazyDocument.hpp>
+#include <core/Sax.hpp>
+#include <core/Utf8.hpp>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    /**
+     * Decodes the escapes in raw string contents.
+     */
+    std::string unescape(const std::string_view raw) {
+        std::string decoded(raw.size(), '\0');
+        const size_t length = unescapeString(raw, decoded.data());
+        if (length == std::string_view::npos) {
+            throw std::runtime_error("Invalid escape in string: " + std::string(raw));
+        }
+        decoded.resize(length);
+        return decoded;
+    }
+
+    bool keyEquals(const std::string_view raw, const std::string_view key) {
+        if (raw.find('\\') == std::string_view::npos) {
+            return raw == key;
+        }
+        // Decoding only ever shortens the text.
+        return key.size() <= raw.size() && unescape(raw) == key;
+    }
+
+    /**
+     * Splits the next reference token off a JSON Pointer and unescapes it.
+     */
+    std::string nextReferenceToken(std::string_view& pointer) {
+        pointer.remove_prefix(1);
+        const size_t end = pointer.find('/');
+        const std::string_view raw = pointer.substr(0, end);
+        pointer.remove_prefix(end == std::string_view::npos ? pointer.size() : end);
+
+        std::string token;
+        token.reserve(raw.size());
+        for (size_t i = 0; i < raw.size(); ++i) {
+            if (raw[i] != '~') {
+                token += raw[i];
+            } else if (i + 1 < raw.size() && (raw[i + 1] == '0' || raw[i + 1] == '1')) {
+                token += raw[++i] == '0' ? '~' : '/';
+            } else {
+                throw std::runtime_error("Invalid JSON Pointer escape in: " + std::string(raw));
+            }
+        }
+        return token;
+    }
+
+    std::optional<size_t> arrayIndex(const std::string_view token) {
+        if (token.empty() || (token.size() > 1 && token[0] == '0')) {
+            return std::nullopt;
+        }
+        size_t index = 0;
+        for (const char c: token) {
+            const auto digit = static_cast<size_t>(c - '0');
+            // An index past size_t cannot name an element.
+            if (c < '0' || c > '9' || index > (std::numeric_limits<size_t>::max() - digit) / 10) {
+                return std::nullopt;
+            }
+            index = index * 10 + digit;
+        }
+        return index;
+    }
+}
+
+LazyValue::Type LazyValue::type() const {
+    switch (head()) {
+        case '{': return Type::Object;
+        case '[': return Type::Array;
+        case '"': return Type::String;
+        case 't':
+        case 'f': return Type::Boolean;
+        case 'n': return Type::Null;
+        default: return Type::Number;
+    }
+}
+
+char LazyValue::head() const {
+    if (document_ == nullptr) {
+        throw std::runtime_error("Empty lazy value");
+    }
+    return document_->input_[document_->index_[entry_]];
+}
+
+size_t LazyValue::nextSibling(const size_t entry) const {
+    const auto& doc = *document_;
+    switch (doc.input_[doc.index_[entry]]) {
+        case '{':
+        case '[': return doc.match_[entry] + 1;
+        case '"': return entry + 2;
+        default: return entry + 1;
+    }
+}
+
+LazyValue LazyValue::find(const std::string_view key) const {
+    if (!*this || head() != '{') {
+        return {};
+    }
+
+    const auto& doc = *document_;
+    const size_t end = doc.match_[entry_];
+    for (size_t entry = entry_ + 1; entry < end;) {
+        if (doc.input_[doc.index_[entry]] != '"' || entry + 3 > end || doc.input_[doc.index_[entry + 2]] != ':') {
+            throw std::runtime_error("Malformed object at offset " + std::to_string(doc.index_[entry]));
+        }
+
+        const size_t keyStart = doc.index_[entry] + 1;
+        const std::string_view candidate = doc.input_.substr(keyStart, doc.index_[entry + 1] - keyStart);
+        const size_t value = entry + 3;
+        if (keyEquals(candidate, key)) {
+            return {document_, value};
+        }
+
+        entry = nextSibling(value);
+        if (entry < end && doc.input_[doc.index_[entry]] == ',') {
+            ++entry;
+        }
+    }
+    return {};
+}
+
+LazyValue LazyValue::find(const size_t index) const {
+    if (!*this || head() != '[') {
+        return {};
+    }
+
+    const auto& doc = *document_;
+    const size_t end = doc.match_[entry_];
+    size_t position = 0;
+    for (size_t entry = entry_ + 1; entry < end; ++position) {
+        if (position == index) {
+            return {document_, entry};
+        }
+
+        entry = nextSibling(entry);
+        if (entry < end && doc.input_[doc.index_[entry]] == ',') {
+            ++entry;
+        }
+    }
+    return {};
+}
+
+LazyValue LazyValue::operator[](const std::string_view key) const {
+    const LazyValue value = find(key);
+    if (!value) {
+        throw std::runtime_error("Key not found: " + std::string(key));
+    }
+    return value;
+}
+
+LazyValue LazyValue::operator[](const size_t index) const {
+    const LazyValue value = find(index);
+    if (!value) {
+        throw std::runtime_error("Array index out of range: " + std::to_string(index));
+    }
+    return value;
+}
+
+size_t LazyValue::size() const {
+    const char c = head();
+    if (c != '{' && c != '[') {
+        throw std::runtime_error("Expected object or array");
+    }
+
+    const auto& doc = *document_;
+    const size_t end = doc.match_[entry_];
+    size_t count = 0;
+    for (size_t entry = entry_ + 1; entry < end; ++count) {
+        entry = nextSibling(c == '{' ? entry + 3 : entry);
+        if (entry < end && doc.input_[doc.index_[entry]] == ',') {
+            ++entry;
+        }
+    }
+    return count;
+}
+
+Token LazyValue::token() const {
+    // The token outlives the tokenizer, so it has to be a view of the input.
+    Tokenizer tokenizer(text());
+    tokenizer.setDecodeEscapes(false);
+    return tokenizer.next();
+}
+
+std::string LazyValue::asString() const {
+    const Token t = token();
+    if (t.type != TokenType::String) {
+        throw std::runtime_error("Expected string, got: " + std::string(t.value));
+    }
+    return unescape(t.value);
+}
+
+JsonNumber LazyValue::asNumber() const {
+    const Token t = token();
+    if (t.type != TokenType::Number) {
+        throw std::runtime_error("Expected number, got: " + std::string(t.value));
+    }
+    return parseJsonNumber(t.value);
+}
+
+bool LazyValue::asBoolean() const {
+    const Token t = token();
+    if (t.type != TokenType::Boolean) {
+        throw std::runtime_error("Expected boolean, got: " + std::string(t.value));
+    }
+    return t.value == "true";
+}
+
+std::shared_ptr<JsonValue> LazyValue::materialize() const {
+    Tokenizer tokenizer(text());
+    TokenStream tokens(tokenizer);
+    DomBuilder builder;
+    if (!parseEvents(tokens, builder)) {
+        throw ParseException(builder.numberError(document_->input_));
+    }
+    return builder.result();
+}
+
+std::string_view LazyValue::text() const {
+    const auto& doc = *document_;
+    const size_t begin = doc.index_[entry_];
+    switch (head()) {
+        case '{':
+        case '[': return doc.input_.substr(begin, doc.index_[doc.match_[entry_]] + 1 - begin);
+        case '"': return doc.input_.substr(begin, doc.index_[entry_ + 1] + 1 - begin);
+        default: {
+            const size_t end = entry_ + 1 < doc.index_.size() ? doc.index_[entry_ + 1] : doc.input_.size();
+            const std::string_view scalar = doc.input_.substr(begin, end - begin);
+            return scalar.substr(0, scalar.find_last_not_of(" \t\n\r") + 1);
+        }
+    }
+}
+
+LazyDocument::LazyDocument(const std::string_view json) : input_(json), index_(json) {
+    matchBrackets();
+}
+
+LazyDocument::LazyDocument(MappedFile file) : file_(std::move(file)), input_(file_->view()), index_(input_) {
+    matchBrackets();
+}
+
+LazyDocument LazyDocument::fromFile(const std::string& path) {
+    return LazyDocument(MappedFile(path));
+}
+
+void LazyDocument::matchBrackets() {
+    if (index_.unterminatedString()) {
+        throw std::runtime_error("Unterminated string");
+    }
+    if (index_.size() == 0) {
+        throw std::runtime_error("Unexpected end of input");
+    }
+
+    match_.assign(index_.size(), 0);
+    std::vector<size_t> open;
+    for (size_t entry = 0; entry < index_.size(); ++entry) {
+        switch (const char c = input_[index_[entry]]) {
+            case '{':
+            case '[':
+                open.push_back(entry);
+                break;
+            case '}':
+            case ']':
+                if (open.empty() || input_[index_[open.back()]] != (c == '}' ? '{' : '[')) {
+                    throw std::runtime_error("Unbalanced bracket at offset " + std::to_string(index_[entry]));
+                }
+                match_[open.back()] = entry;
+                match_[entry] = open.back();
+                open.pop_back();
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (!open.empty()) {
+        throw std::runtime_error("Unexpected end of input");
+    }
+}
+
+LazyValue LazyDocument::root() const {
+    return {this, 0};
+}
+
+LazyValue LazyDocument::at(const std::string_view pointer) const {
+    const LazyValue value = find(pointer);
+    if (!value) {
+        throw std::runtime_error("JSON Pointer does not resolve: " + std::string(pointer));
+    }
+    return value;
+}
+
+LazyValue LazyDocument::find(std::string_view pointer) const {
+    if (!pointer.empty() && pointer[0] != '/') {
+        throw std::runtime_error("JSON Pointer must start with '/': " + std::string(pointer));
+    }
+
+    LazyValue value = root();
+    while (value && !pointer.empty()) {
+        const std::string token = nextReferenceToken(pointer);
+        if (value.type() == LazyValue::Type::Array) {
+            const auto index = arrayIndex(token);
+            value = index ? value.find(*index) : LazyValue();
+        } else {
+            value = value.find(token);
+        }
+    }
+    return value;
+}
@@ -0,0 +1,169 @@
+#include <core/MappedFile.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSONPARSER_POSIX 1
+#endif
+
+namespace {
+    void checkPath(const std::string& path) {
+        namespace fs = std::filesystem;
+
+        if (!fs::exists(path)) {
+            throw std::runtime_error("File not found: " + path);
+        }
+
+        if (fs::is_directory(path)) {
+            throw std::runtime_error("Path is a directory: " + path);
+        }
+    }
+
+    /**
+     * Reads until end of file, for pipes and devices whose size is not known
+     * up front. The buffer doubles as it fills.
+     *
+     * @param read Reads up to n bytes to p, returning the count, 0 at end of
+     * file or a negative value on error.
+     * @return The number of bytes read.
+     */
+    template<typename Read>
+    size_t readToEnd(std::unique_ptr<char[]>& buffer, Read read) {
+        size_t capacity = 64 * 1024;
+        size_t size = 0;
+        buffer = std::make_unique_for_overwrite<char[]>(capacity);
+        while (true) {
+            if (size == capacity) {
+                auto grown = std::make_unique_for_overwrite<char[]>(capacity * 2);
+                std::memcpy(grown.get(), buffer.get(), size);
+                buffer = std::move(grown);
+                capacity *= 2;
+            }
+            const auto n = read(buffer.get() + size, capacity - size);
+            if (n < 0) {
+                return static_cast<size_t>(-1);
+            }
+            if (n == 0) {
+                return size;
+            }
+            size += static_cast<size_t>(n);
+        }
+    }
+}
+
+MappedFile::MappedFile(const std::string& path) {
+    checkPath(path);
+
+#ifdef JSONPARSER_POSIX
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    struct stat status{};
+    if (::fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    if (!S_ISREG(status.st_mode)) {
+        size_ = readToEnd(buffer_, [fd](char* p, const size_t n) { return ::read(fd, p, n); });
+        ::close(fd);
+        if (size_ == static_cast<size_t>(-1)) {
+            size_ = 0;
+            throw std::runtime_error("Failed to read file: " + path);
+        }
+        data_ = buffer_.get();
+        return;
+    }
+    size_ = static_cast<size_t>(status.st_size);
+
+    if (size_ > 0) {
+        if (void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0); address != MAP_FAILED) {
+            ::madvise(address, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(address);
+            mapped_ = true;
+        } else {
+            buffer_ = std::make_unique_for_overwrite<char[]>(size_);
+            size_t done = 0;
+            while (done < size_) {
+                const ssize_t n = ::read(fd, buffer_.get() + done, size_ - done);
+                if (n <= 0) {
+                    ::close(fd);
+                    throw std::runtime_error("Failed to read file: " + path);
+                }
+                done += static_cast<size_t>(n);
+            }
+            data_ = buffer_.get();
+        }
+    }
+
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    if (std::filesystem::is_regular_file(path)) {
+        file.seekg(0, std::ios::end);
+        size_ = static_cast<size_t>(file.tellg());
+        buffer_ = std::make_unique_for_overwrite<char[]>(size_);
+        file.seekg(0);
+        if (!file.read(buffer_.get(), static_cast<std::streamsize>(size_))) {
+            throw std::runtime_error("Failed to read file: " + path);
+        }
+    } else {
+        size_ = readToEnd(buffer_, [&file](char* p, const size_t n) -> std::streamsize {
+            file.read(p, static_cast<std::streamsize>(n));
+            return file.bad() ? -1 : file.gcount();
+        });
+        if (size_ == static_cast<size_t>(-1)) {
+            size_ = 0;
+            throw std::runtime_error("Failed to read file: " + path);
+        }
+    }
+    data_ = buffer_.get();
+#endif
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mapped_(std::exchange(other.mapped_, false)),
+      buffer_(std::move(other.buffer_)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, false);
+        buffer_ = std::move(other.buffer_);
+    }
+    return *this;
+}
+
+void MappedFile::unmap() {
+#ifdef JSONPARSER_POSIX
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    buffer_.reset();
+}
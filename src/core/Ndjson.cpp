@@ -0,0 +1,194 @@
+#include <core/Ndjson.hpp>
+#include <core/MappedFile.hpp>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <stdexcept>
+
+namespace {
+    struct Batch {
+        size_t index{};
+        std::vector<NdjsonRecord> records;
+        std::exception_ptr failure;
+    };
+
+    bool isBlank(const std::string_view line) {
+        return line.find_first_not_of(" \t\r") == std::string_view::npos;
+    }
+
+    std::vector<NdjsonRecord> parseBatch(const std::string_view input, const size_t begin, const size_t end) {
+        std::vector<NdjsonRecord> records;
+        // One tokenizer and builder serve the whole batch, so their buffers
+        // are allocated once rather than per line.
+        Tokenizer tokenizer({});
+        DomBuilder builder;
+
+        for (size_t pos = begin; pos < end;) {
+            size_t lineEnd = input.find('\n', pos);
+            if (lineEnd == std::string_view::npos || lineEnd > end) {
+                lineEnd = end;
+            }
+
+            std::string_view line = input.substr(pos, lineEnd - pos);
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+
+            if (!isBlank(line)) {
+                NdjsonRecord record;
+                record.offset = pos;
+                try {
+                    tokenizer.reset(line);
+                    TokenStream tokens(tokenizer);
+                    if (!parseEvents(tokens, builder)) {
+                        throw ParseException(builder.numberError(line));
+                    }
+                    if (tokens.peek().type != TokenType::End) {
+                        throw ParseException(ParseError{ParseErrorCode::TrailingContent, 0, 0, tokens.peek().offset});
+                    }
+                    record.value = builder.result();
+                } catch (const ParseException& ex) {
+                    // Offsets are relative to the line, which the record's
+                    // offset already locates in the input.
+                    ParseError error = ex.error();
+                    error.locate(line);
+                    record.error = std::string(describe(error.code)) + " at column " + std::to_string(error.column);
+                    builder.reset();
+                }
+                records.push_back(std::move(record));
+            }
+
+            pos = lineEnd + 1;
+        }
+
+        return records;
+    }
+
+    /**
+     * Hands batches to the pool and collects them on the calling thread.
+     */
+    class BatchScheduler {
+    public:
+        BatchScheduler(const std::string_view input, const NdjsonOptions& options, WorkerPool& pool)
+            : input_(input), options_(options), pool_(pool), maxInFlight_(pool.size() * 4) {
+        }
+
+        ~BatchScheduler() {
+            for (; collected_ < scheduled_; ++collected_) {
+                completedCount_.acquire();
+            }
+        }
+
+        void run(const NdjsonSink& sink) {
+            std::map<size_t, std::vector<NdjsonRecord> > pending;
+            size_t nextToDeliver = 0;
+
+            schedule();
+            while (collected_ < scheduled_) {
+                completedCount_.acquire();
+                ++collected_;
+
+                Batch batch;
+                {
+                    std::lock_guard lock(mutex_);
+                    batch = std::move(completed_.front());
+                    completed_.pop_front();
+                }
+
+                if (batch.failure) {
+                    std::rethrow_exception(batch.failure);
+                }
+
+                if (!options_.ordered) {
+                    deliver(batch.records, sink);
+                } else {
+                    pending.emplace(batch.index, std::move(batch.records));
+                    for (auto it = pending.begin(); it != pending.end() && it->first == nextToDeliver; it = pending.begin()) {
+                        deliver(it->second, sink);
+                        pending.erase(it);
+                        ++nextToDeliver;
+                    }
+                }
+
+                schedule();
+            }
+        }
+
+    private:
+        static void deliver(std::vector<NdjsonRecord>& records, const NdjsonSink& sink) {
+            for (auto& record: records) {
+                sink(std::move(record));
+            }
+        }
+
+        void schedule() {
+            while (scheduled_ - collected_ < maxInFlight_ && nextOffset_ < input_.size()) {
+                const size_t begin = nextOffset_;
+                size_t end = input_.find('\n', std::min(begin + std::max<size_t>(options_.batchBytes, 1), input_.size()) - 1);
+                end = end == std::string_view::npos ? input_.size() : end + 1;
+
+                nextOffset_ = end;
+                pool_.submit([this, index = scheduled_++, begin, end] {
+                    Batch batch;
+                    batch.index = index;
+                    try {
+                        batch.records = parseBatch(input_, begin, end);
+                    } catch (...) {
+                        batch.failure = std::current_exception();
+                    }
+
+                    {
+                        std::lock_guard guard(mutex_);
+                        completed_.push_back(std::move(batch));
+                    }
+                    completedCount_.release();
+                });
+            }
+        }
+
+        std::string_view input_;
+        const NdjsonOptions& options_;
+        WorkerPool& pool_;
+        size_t maxInFlight_;
+        size_t nextOffset_{};
+        size_t scheduled_{};
+        size_t collected_{};
+
+        std::mutex mutex_;
+        std::deque<Batch> completed_;
+        std::counting_semaphore<> completedCount_{0};
+    };
+}
+
+void parseNdjson(const std::string_view input, const NdjsonSink& sink, const NdjsonOptions& options) {
+    std::optional<WorkerPool> ownPool;
+    WorkerPool* pool = options.pool;
+    if (pool == nullptr) {
+        pool = &ownPool.emplace(options.threads);
+    }
+
+    BatchScheduler scheduler(input, options, *pool);
+    scheduler.run(sink);
+}
+
+std::vector<std::shared_ptr<JsonValue>> parseNdjson(const std::string_view input, const NdjsonOptions& options) {
+    NdjsonOptions ordered = options;
+    ordered.ordered = true;
+
+    std::vector<std::shared_ptr<JsonValue> > values;
+    parseNdjson(input, [&](NdjsonRecord&& record) {
+        if (!record.value) {
+            throw std::runtime_error("Invalid record at offset " + std::to_string(record.offset) + ": " + record.error);
+        }
+        values.push_back(std::move(record.value));
+    }, ordered);
+    return values;
+}
+
+void parseNdjsonFile(const std::string& path, const NdjsonSink& sink, const NdjsonOptions& options) {
+    const MappedFile file(path);
+    parseNdjson(file.view(), sink, options);
+}
@@ -0,0 +1,144 @@
+#include <core/Number.hpp>
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    bool isDigit(const char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    /**
+     * Whether an out-of-range double is an underflow: the first significant
+     * digit sits after the decimal point once the exponent is applied.
+     */
+    bool isUnderflow(const std::string_view text) {
+        size_t i = text[0] == '-' ? 1 : 0;
+        long magnitude = 0;
+
+        while (i < text.size() && isDigit(text[i])) {
+            if (text[i] != '0' || magnitude > 0) {
+                ++magnitude;
+            }
+            ++i;
+        }
+        if (magnitude == 0 && i < text.size() && text[i] == '.') {
+            for (++i; i < text.size() && text[i] == '0'; ++i) {
+                --magnitude;
+            }
+        }
+
+        if (const size_t e = text.find_first_of("eE"); e != std::string_view::npos) {
+            long exponent = 0;
+            size_t j = e + 1;
+            const bool negative = text[j] == '-';
+            if (text[j] == '-' || text[j] == '+') {
+                ++j;
+            }
+            for (; j < text.size() && exponent < 1'000'000'000; ++j) {
+                exponent = exponent * 10 + (text[j] - '0');
+            }
+            magnitude += negative ? -exponent : exponent;
+        }
+
+        return magnitude <= 0;
+    }
+}
+
+size_t scanNumber(const std::string_view input) {
+    size_t i = 0;
+    while (i < input.size()) {
+        const char c = input[i];
+        if (!isDigit(c) && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {
+            break;
+        }
+        ++i;
+    }
+    return i;
+}
+
+bool isJsonNumber(const std::string_view text) {
+    size_t i = 0;
+    const size_t n = text.size();
+
+    if (i < n && text[i] == '-') {
+        ++i;
+    }
+    if (i == n) {
+        return false;
+    }
+    if (text[i] == '0') {
+        ++i;
+    } else if (isDigit(text[i])) {
+        while (i < n && isDigit(text[i])) {
+            ++i;
+        }
+    } else {
+        return false;
+    }
+
+    if (i < n && text[i] == '.') {
+        const size_t digits = ++i;
+        while (i < n && isDigit(text[i])) {
+            ++i;
+        }
+        if (i == digits) {
+            return false;
+        }
+    }
+
+    if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+        ++i;
+        if (i < n && (text[i] == '+' || text[i] == '-')) {
+            ++i;
+        }
+        const size_t digits = i;
+        while (i < n && isDigit(text[i])) {
+            ++i;
+        }
+        if (i == digits) {
+            return false;
+        }
+    }
+
+    return i == n;
+}
+
+std::optional<JsonNumber> tryParseJsonNumber(const std::string_view text) noexcept {
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+
+    if (text.find_first_of(".eE") == std::string_view::npos) {
+        int64_t integer;
+        if (const auto [ptr, ec] = std::from_chars(first, last, integer); ec == std::errc() && ptr == last) {
+            return integer;
+        }
+        uint64_t unsignedInteger;
+        if (const auto [ptr, ec] = std::from_chars(first, last, unsignedInteger); ec == std::errc() && ptr == last) {
+            return unsignedInteger;
+        }
+    }
+
+    double real;
+    const auto [ptr, ec] = std::from_chars(first, last, real);
+    if (ec == std::errc::result_out_of_range) {
+        if (!isUnderflow(text)) {
+            return std::nullopt;
+        }
+        return text[0] == '-' ? -0.0 : 0.0;
+    }
+    if (ec != std::errc() || ptr != last) {
+        return std::nullopt;
+    }
+    return real;
+}
+
+JsonNumber parseJsonNumber(const std::string_view text) {
+    if (const std::optional<JsonNumber> number = tryParseJsonNumber(text)) {
+        return *number;
+    }
+    if (isJsonNumber(text)) {
+        throw std::runtime_error("Number out of range: " + std::string(text));
+    }
+    throw std::runtime_error("Invalid number: " + std::string(text));
+}
@@ -0,0 +1,170 @@
+#include <core/ParallelArray.hpp>
+#include <core/MappedFile.hpp>
+#include <core/StructuralIndex.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <semaphore>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    bool isBlank(const std::string_view text) {
+        return text.find_first_not_of(" \t\n\r") == std::string_view::npos;
+    }
+
+    /**
+     * Parses `count` comma-separated values from json[begin, end), nested
+     * `depth` levels deep in the document.
+     *
+     * @throws ParseException located in the whole of json.
+     */
+    JsonArray parseElements(const std::string_view json, const size_t begin, const size_t end, const size_t count,
+                            const size_t depth) {
+        const std::string_view text = json.substr(begin, end - begin);
+        try {
+            JsonArray elements;
+            elements.reserve(count);
+
+            Tokenizer tokenizer(text);
+            TokenStream tokens(tokenizer);
+            DomBuilder builder;
+            SaxReader reader(tokens, builder);
+            reader.setDepth(depth);
+            for (size_t i = 0; i < count; ++i) {
+                if (i > 0) {
+                    if (tokens.peek().type != TokenType::Comma) {
+                        throw ParseException(ParseError{ParseErrorCode::ExpectedCommaOrEnd, 0, 0, tokens.peek().offset});
+                    }
+                    tokens.advance();
+                }
+                if (!reader.parseValue()) {
+                    throw ParseException(builder.numberError(text));
+                }
+                elements.push_back(builder.result());
+            }
+            if (tokens.peek().type != TokenType::End) {
+                const auto code = end == json.size() ? ParseErrorCode::TrailingContent : ParseErrorCode::ExpectedCommaOrEnd;
+                throw ParseException(ParseError{code, 0, 0, tokens.peek().offset});
+            }
+            return elements;
+        } catch (const ParseException& exception) {
+            ParseError error = exception.error();
+            // A chunk stops at the separator after its last element, which
+            // is a token of the whole input rather than its end.
+            if (error.code == ParseErrorCode::UnexpectedEnd && end < json.size()) {
+                error.code = ParseErrorCode::UnexpectedToken;
+            }
+            error.offset += begin;
+            throw ParseException(error.locate(json));
+        }
+    }
+
+    std::shared_ptr<JsonValue> parseSequential(const std::string_view json) {
+        return parseElements(json, 0, json.size(), 1, 0).front();
+    }
+
+    /**
+     * True if the separators describe one root array followed by nothing but whitespace.
+     */
+    bool isArrayRoot(const std::string_view json, const std::vector<size_t>& separators) {
+        if (separators.size() < 2 || json[separators.front()] != '[' || json[separators.back()] != ']') {
+            return false;
+        }
+        for (size_t i = 1; i + 1 < separators.size(); ++i) {
+            if (json[separators[i]] != ',') {
+                return false;
+            }
+        }
+        return isBlank(json.substr(0, separators.front())) && isBlank(json.substr(separators.back() + 1));
+    }
+}
+
+std::shared_ptr<JsonValue> parseArrayParallel(const std::string_view json, const ParallelArrayOptions& options) {
+    if (json.size() <= options.chunkBytes) {
+        return parseSequential(json);
+    }
+
+    const std::vector<size_t> separators = StructuralIndex::topLevelSeparators(json);
+    if (!isArrayRoot(json, separators)) {
+        return parseSequential(json);
+    }
+
+    const size_t elementCount = separators.size() - 1;
+    if (elementCount == 1 && isBlank(json.substr(separators[0] + 1, separators[1] - separators[0] - 1))) {
+        return std::make_shared<JsonValue>(JsonArray{});
+    }
+
+    // Chunk i covers the elements between separators[bounds[i]] and separators[bounds[i + 1]].
+    std::vector<size_t> bounds{0};
+    for (size_t i = 1; i < separators.size(); ++i) {
+        if (separators[i] - separators[bounds.back()] >= options.chunkBytes || i + 1 == separators.size()) {
+            bounds.push_back(i);
+        }
+    }
+    const size_t chunkCount = bounds.size() - 1;
+
+    std::optional<WorkerPool> ownPool;
+    WorkerPool* pool = options.pool;
+    if (pool == nullptr) {
+        pool = &ownPool.emplace(options.threads);
+    }
+
+    std::vector<JsonArray> chunks(chunkCount);
+    std::vector<std::exception_ptr> failures(chunkCount);
+    const auto parseChunk = [&](const size_t i) {
+        const size_t begin = separators[bounds[i]] + 1;
+        const size_t end = separators[bounds[i + 1]];
+        try {
+            // The elements are one level inside the root array.
+            chunks[i] = parseElements(json, begin, end, bounds[i + 1] - bounds[i], 1);
+        } catch (...) {
+            failures[i] = std::current_exception();
+        }
+    };
+
+    // Workers and the calling thread claim chunks from a shared counter, so
+    // the caller parses whatever no worker has started. Waiting therefore
+    // only ever waits for running chunks, and a call from a task on the
+    // same pool cannot deadlock. Tasks that start after the last chunk was
+    // claimed touch nothing but the shared state, which they keep alive.
+    struct Claims {
+        explicit Claims(const size_t count) : count(count) {
+        }
+
+        const size_t count;
+        std::atomic<size_t> next{0};
+        std::counting_semaphore<> finished{0};
+    };
+    const auto claims = std::make_shared<Claims>(chunkCount);
+    const auto parseClaimed = [claims, &parseChunk] {
+        for (size_t i; (i = claims->next++) < claims->count;) {
+            parseChunk(i);
+            claims->finished.release();
+        }
+    };
+    for (size_t i = 0; i < std::min(chunkCount, pool->size()); ++i) {
+        pool->submit(parseClaimed);
+    }
+    parseClaimed();
+    for (size_t i = 0; i < chunkCount; ++i) {
+        claims->finished.acquire();
+    }
+
+    JsonArray elements;
+    elements.reserve(elementCount);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        if (failures[i]) {
+            std::rethrow_exception(failures[i]);
+        }
+        std::move(chunks[i].begin(), chunks[i].end(), std::back_inserter(elements));
+    }
+    return std::make_shared<JsonValue>(std::move(elements));
+}
+
+std::shared_ptr<JsonValue> parseArrayParallelFile(const std::string& path, const ParallelArrayOptions& options) {
+    const MappedFile file(path);
+    return parseArrayParallel(file.view(), options);
+}
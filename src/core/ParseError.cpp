@@ -0,0 +1,42 @@
+#include <core/ParseError.hpp>
+#include <algorithm>
+
+const char* describe(const ParseErrorCode code) {
+    switch (code) {
+        case ParseErrorCode::UnexpectedEnd: return "Unexpected end of input";
+        case ParseErrorCode::UnexpectedToken: return "Unexpected token";
+        case ParseErrorCode::ExpectedKey: return "Expected string key";
+        case ParseErrorCode::ExpectedColon: return "Expected ':'";
+        case ParseErrorCode::ExpectedCommaOrEnd: return "Expected ',' or end of container";
+        case ParseErrorCode::UnterminatedString: return "Unterminated string";
+        case ParseErrorCode::InvalidNumber: return "Invalid number";
+        case ParseErrorCode::NumberOutOfRange: return "Number out of range";
+        case ParseErrorCode::InvalidKeyword: return "Invalid keyword";
+        case ParseErrorCode::InvalidCharacter: return "Invalid character";
+        case ParseErrorCode::TrailingContent: return "Unexpected content after value";
+        case ParseErrorCode::OutOfMemory: return "Out of memory";
+        case ParseErrorCode::InvalidEscape: return "Invalid escape sequence";
+        case ParseErrorCode::ControlCharacter: return "Unescaped control character in string";
+        case ParseErrorCode::InvalidUtf8: return "Invalid UTF-8";
+        case ParseErrorCode::TooDeep: return "Nesting too deep";
+    }
+    return "Unknown error";
+}
+
+ParseError& ParseError::locate(const std::string_view input) {
+    const std::string_view before = input.substr(0, std::min(offset, input.size()));
+    const size_t lineStart = before.rfind('\n');
+    line = static_cast<uint32_t>(std::count(before.begin(), before.end(), '\n') + 1);
+    column = static_cast<uint32_t>(lineStart == std::string_view::npos ? before.size() + 1 : before.size() - lineStart);
+    return *this;
+}
+
+std::string ParseError::message() const {
+    std::string result = describe(code);
+    if (line != 0) {
+        result += " at line " + std::to_string(line) + ", column " + std::to_string(column);
+    } else {
+        result += " at offset " + std::to_string(offset);
+    }
+    return result;
+}
@@ -1,131 +1,156 @@
 #include <core/Parser.hpp>
-#include <core/FileReader.hpp>
+#include <core/Number.hpp>
 #include <iostream>
+#include <stdexcept>
 
-Parser::Parser(std::vector<Token> &tokens): tokens_(tokens) {
+bool DomBuilder::onStartObject() {
+    stack_.emplace_back(JsonObject{});
+    keys_.emplace_back();
+    return true;
 }
 
-Parser::Parser(const std::string &inputOrFilePath, const bool isFile)
-    : tokens_([&]() {
-        const std::string jsonInput = isFile ? FileReader::read(inputOrFilePath) : inputOrFilePath;
-        Tokenizer tokenizer(jsonInput);
-        return tokenizer.tokenize();
-    }()) {
+bool DomBuilder::onKey(const std::string_view key) {
+    keys_.back() = key;
+    return true;
 }
 
-std::shared_ptr<JsonValue> Parser::parse() {
-    return parseValue();
-}
-
-std::shared_ptr<JsonValue> Parser::parseValue() {
-    switch (const Token &token = peek(); token.type) {
-        case TokenType::LeftBrace:
-            return std::make_shared<JsonValue>(parseObject());
-        case TokenType::LeftBracket:
-            return std::make_shared<JsonValue>(parseArray());
-        case TokenType::String:
-            return std::make_shared<JsonValue>(parseString());
-        case TokenType::Number:
-            return std::make_shared<JsonValue>(parseNumber());
-        case TokenType::Boolean:
-            return std::make_shared<JsonValue>(parseBoolean());
-        case TokenType::Null:
-            return std::make_shared<JsonValue>(parseNull());
-        default: throw std::runtime_error("Unexpected token:" + token.value);
-    }
+bool DomBuilder::onEndObject() {
+    JsonValue::ValueType object = std::move(stack_.back());
+    stack_.pop_back();
+    keys_.pop_back();
+    return add(std::move(object));
 }
 
+bool DomBuilder::onStartArray() {
+    stack_.emplace_back(JsonArray{});
+    return true;
+}
 
-JsonObject Parser::parseObject() {
-    expect(TokenType::LeftBrace);
-    JsonObject object;
+bool DomBuilder::onEndArray() {
+    JsonValue::ValueType array = std::move(stack_.back());
+    stack_.pop_back();
+    return add(std::move(array));
+}
 
-    while (peek().type != TokenType::RightBrace) {
-        std::string key = parseString();
-        expect(TokenType::Colon);
-        auto value = parseValue();
-        object.emplace(std::move(key), std::move(value));
+bool DomBuilder::onString(const std::string_view value) {
+    return add(std::string(value));
+}
 
-        if (peek().type == TokenType::Comma) {
-            advance();
-        } else {
-            break;
-        }
+bool DomBuilder::onNumber(const std::string_view text) {
+    const std::optional<JsonNumber> number = tryParseJsonNumber(text);
+    if (!number) {
+        numberOutOfRange_ = text.data();
+        return false;
     }
-
-    expect(TokenType::RightBrace);
-    return object;
+    return add(std::visit([](const auto value) { return JsonValue::ValueType(value); }, *number));
 }
 
-JsonArray Parser::parseArray() {
-    expect(TokenType::LeftBracket);
-    JsonArray array;
+bool DomBuilder::onBoolean(const bool value) {
+    return add(value);
+}
 
-    while (peek().type != TokenType::RightBracket) {
-        array.push_back(parseValue());
+bool DomBuilder::onNull() {
+    return add(nullptr);
+}
 
-        if (peek().type == TokenType::Comma) {
-            advance();
-        } else {
-            break;
-        }
-    }
+ParseError DomBuilder::numberError(const std::string_view input) const {
+    const auto offset = static_cast<size_t>(numberOutOfRange_ - input.data());
+    return ParseError{ParseErrorCode::NumberOutOfRange, 0, 0, offset}.locate(input);
+}
 
-    expect(TokenType::RightBracket);
-    return array;
+void DomBuilder::reset() {
+    stack_.clear();
+    keys_.clear();
+    root_.reset();
+    numberOutOfRange_ = nullptr;
 }
 
-std::string Parser::parseString() {
-    const Token &token = advance();
-    if (TokenType::String != token.type) {
-        throw std::runtime_error("Expected string, got: " + token.value);
+bool DomBuilder::add(JsonValue::ValueType value) {
+    auto node = std::make_shared<JsonValue>(std::move(value));
+
+    if (stack_.empty()) {
+        root_ = std::move(node);
+    } else if (auto *object = std::get_if<JsonObject>(&stack_.back())) {
+        object->emplace(std::move(keys_.back()), std::move(node));
+    } else {
+        std::get<JsonArray>(stack_.back()).push_back(std::move(node));
     }
-    return token.value;
+    return true;
 }
 
-double Parser::parseNumber() {
-    const Token &token = advance();
-    if (TokenType::Number != token.type) {
-        throw std::runtime_error("Expected number, got: " + token.value);
-    }
-    return std::stod(token.value);
+Parser::Parser(const std::span<const Token> tokens, const std::string_view text): tokens_(tokens), text_(text) {
 }
 
-bool Parser::parseBoolean() {
-    const Token &token = advance();
+Parser::Parser(const std::string &inputOrFilePath, const bool isFile) {
+    reset(inputOrFilePath, isFile);
+}
 
-    if (TokenType::Boolean != token.type) {
-        throw std::runtime_error("Expected boolean, got: " + token.value);
+void Parser::reset(const std::string_view inputOrFilePath, const bool isFile) {
+    tokens_ = {};
+    text_ = {};
+    // Detach the tokenizer first, so that it never refers to an unmapped
+    // file if mapping the new one fails.
+    if (tokenizer_) {
+        tokenizer_->reset({});
     }
 
-    return token.value == "true";
-}
-
-std::nullptr_t Parser::parseNull() {
-    if (const Token &token = advance(); token.value != "null") {
-        throw std::runtime_error("Expected null, got: " + token.value);
+    std::string_view text;
+    if (isFile) {
+        file_.reset();
+        file_.emplace(std::string(inputOrFilePath));
+        input_.clear();
+        text = file_->view();
+    } else {
+        // Assigning keeps the capacity of earlier, longer documents.
+        input_.assign(inputOrFilePath);
+        file_.reset();
+        text = input_;
     }
 
-    return nullptr;
+    if (tokenizer_) {
+        tokenizer_->reset(text);
+    } else {
+        tokenizer_.emplace(text);
+    }
 }
 
-const Token &Parser::peek() const {
-    return tokens_[currentIndex_];
+void Parser::reset(const std::span<const Token> tokens, const std::string_view text) {
+    tokenizer_.reset();
+    file_.reset();
+    input_.clear();
+    tokens_ = tokens;
+    text_ = text;
 }
 
-const Token &Parser::advance() {
-    if (currentIndex_ >= tokens_.size()) {
-        throw std::runtime_error("Unexpected end of input");
+std::shared_ptr<JsonValue> Parser::parse() {
+    builder_.reset();
+    if (!parse(builder_)) {
+        // The builder only stops the parse for a number out of range.
+        fail(ParseError{ParseErrorCode::NumberOutOfRange, 0, 0, offsetOf(builder_.numberOutOfRange())});
     }
+    return builder_.result();
+}
 
-    return tokens_[currentIndex_++];
+size_t Parser::offsetOf(const char* text) const {
+    if (tokenizer_) {
+        // Number tokens are views of the input.
+        return static_cast<size_t>(text - (file_ ? file_->data() : input_.data()));
+    }
+    // Pre-tokenized input has no text, but the token knows its offset.
+    for (const Token& token: tokens_) {
+        if (token.value.data() == text) {
+            return token.offset;
+        }
+    }
+    return 0;
 }
 
-void Parser::expect(TokenType type) {
-    if (this->peek().type != type) {
-        throw std::runtime_error(
-            "Expected token: " + std::to_string(static_cast<int>(type)) + ", got: " + std::to_string(
-                static_cast<int>(this->peek().type)));
+void Parser::fail(ParseError error) const {
+    // Pre-tokenized input may come without its text.
+    if (tokenizer_) {
+        error.locate(file_ ? file_->view() : std::string_view(input_));
+    } else if (!text_.empty()) {
+        error.locate(text_);
     }
-    advance();
+    throw ParseException(error);
 }
@@ -0,0 +1,42 @@
+#include <core/ParserPool.hpp>
+#include <vector>
+
+namespace {
+    std::vector<std::unique_ptr<Parser> >& idleParsers() {
+        thread_local std::vector<std::unique_ptr<Parser> > parsers = [] {
+            std::vector<std::unique_ptr<Parser> > reserved;
+            reserved.reserve(ParserPool::MaxIdle);
+            return reserved;
+        }();
+        return parsers;
+    }
+}
+
+ParserPool::Lease::~Lease() {
+    if (!parser_) {
+        return;
+    }
+    if (auto& parsers = idleParsers(); parsers.size() < MaxIdle) {
+        parsers.push_back(std::move(parser_));
+    }
+}
+
+ParserPool::Lease ParserPool::acquire() {
+    auto& parsers = idleParsers();
+    if (parsers.empty()) {
+        return Lease(std::make_unique<Parser>());
+    }
+    std::unique_ptr<Parser> parser = std::move(parsers.back());
+    parsers.pop_back();
+    return Lease(std::move(parser));
+}
+
+ParserPool::Lease ParserPool::acquire(const std::string_view json) {
+    Lease lease = acquire();
+    lease->reset(json);
+    return lease;
+}
+
+size_t ParserPool::idle() {
+    return idleParsers().size();
+}
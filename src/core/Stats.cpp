@@ -0,0 +1,206 @@
+#include <core/Stats.hpp>
+#include <core/FileReader.hpp>
+#include <core/Tokenizer.hpp>
+#include <core/Writer.hpp>
+#include <cstdio>
+#include <numeric>
+
+#ifdef JSON_STATS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> heapAllocations{0};
+    std::atomic<uint64_t> heapBytes{0};
+
+    void count(const size_t size) {
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        heapBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void* allocate(const size_t size) {
+        count(size);
+        if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(const size_t size, const std::align_val_t alignment) {
+        count(size);
+        const auto align = static_cast<size_t>(alignment);
+        if (void* memory = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(const size_t size) { return allocate(size); }
+void* operator new[](const size_t size) { return allocate(size); }
+void* operator new(const size_t size, const std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](const size_t size, const std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { std::free(memory); }
+
+HeapCounters heapCounters() noexcept {
+    return {heapAllocations.load(std::memory_order_relaxed), heapBytes.load(std::memory_order_relaxed)};
+}
+#else
+HeapCounters heapCounters() noexcept {
+    return {};
+}
+#endif
+
+PhaseTimer::PhaseTimer(ParseStats& stats, std::string name, const size_t bytes)
+    : stats_(&stats), phase_{std::move(name), 0, bytes, {}}, heapStart_(heapCounters()) {
+    // Read the clock last so that the setup above is not timed.
+    start_ = std::chrono::steady_clock::now();
+}
+
+void PhaseTimer::stop() {
+    if (stats_ == nullptr) {
+        return;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    phase_.heap = heapCounters() - heapStart_;
+    phase_.milliseconds = std::chrono::duration<double, std::milli>(end - start_).count();
+    stats_->phases.push_back(std::move(phase_));
+    stats_ = nullptr;
+}
+
+const PhaseStats* ParseStats::phase(const std::string_view name) const {
+    for (const PhaseStats& candidate: phases) {
+        if (candidate.name == name) {
+            return &candidate;
+        }
+    }
+    return nullptr;
+}
+
+double ParseStats::totalMilliseconds() const {
+    return std::accumulate(phases.begin(), phases.end(), 0.0,
+                           [](const double sum, const PhaseStats& phase) { return sum + phase.milliseconds; });
+}
+
+std::string ParseStats::toJson() const {
+    JsonWriter writer;
+    const auto field = [&](const std::string_view key, const uint64_t value) {
+        writer.onKey(key);
+        writer.writeNumber(value);
+    };
+    const auto heapField = [&](const std::string_view key, const uint64_t value) {
+        writer.onKey(key);
+        if constexpr (HeapStatsEnabled) {
+            writer.writeNumber(value);
+        } else {
+            writer.onNull();
+        }
+    };
+
+    writer.onStartObject();
+    field("inputBytes", inputBytes);
+    field("tokens", tokens);
+    field("nodes", nodes);
+    field("maxDepth", maxDepth);
+    writer.onKey("totalMs");
+    writer.writeNumber(totalMilliseconds());
+
+    writer.onKey("phases");
+    writer.onStartArray();
+    for (const PhaseStats& phase: phases) {
+        writer.onStartObject();
+        writer.onKey("name");
+        writer.onString(phase.name);
+        writer.onKey("ms");
+        writer.writeNumber(phase.milliseconds);
+        field("bytes", phase.bytes);
+        heapField("allocations", phase.heap.allocations);
+        heapField("allocatedBytes", phase.heap.bytes);
+        writer.onEndObject();
+    }
+    writer.onEndArray();
+    writer.onEndObject();
+    return writer.take();
+}
+
+std::string ParseStats::toText() const {
+    std::string text;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-10s %12s %12s %14s %16s\n", "phase", "time (ms)", "MB/s", "allocations",
+                  "allocated bytes");
+    text += line;
+
+    for (const PhaseStats& phase: phases) {
+        char throughput[32] = "-";
+        if (phase.bytes > 0 && phase.milliseconds > 0) {
+            std::snprintf(throughput, sizeof(throughput), "%.1f",
+                          static_cast<double>(phase.bytes) / 1e6 / (phase.milliseconds / 1e3));
+        }
+        if constexpr (HeapStatsEnabled) {
+            std::snprintf(line, sizeof(line), "%-10s %12.3f %12s %14llu %16llu\n", phase.name.c_str(),
+                          phase.milliseconds, throughput, static_cast<unsigned long long>(phase.heap.allocations),
+                          static_cast<unsigned long long>(phase.heap.bytes));
+        } else {
+            std::snprintf(line, sizeof(line), "%-10s %12.3f %12s %14s %16s\n", phase.name.c_str(),
+                          phase.milliseconds, throughput, "n/a", "n/a");
+        }
+        text += line;
+    }
+
+    std::snprintf(line, sizeof(line), "%-10s %12.3f\n", "total", totalMilliseconds());
+    text += line;
+    std::snprintf(line, sizeof(line), "%zu bytes, %zu tokens, %zu nodes, max depth %zu\n", inputBytes, tokens, nodes,
+                  maxDepth);
+    text += line;
+    if constexpr (!HeapStatsEnabled) {
+        text += "Heap counters need a build with -DJSON_STATS=ON.\n";
+    }
+    return text;
+}
+
+std::shared_ptr<JsonValue> parseWithStats(const std::string& inputOrFilePath, const bool isFile, ParseStats& stats) {
+    std::string contents;
+    if (isFile) {
+        PhaseTimer timer(stats, "read");
+        contents = FileReader::read(inputOrFilePath);
+        timer.stop();
+        stats.phases.back().bytes = contents.size();
+    }
+    const std::string_view text = isFile ? std::string_view(contents) : std::string_view(inputOrFilePath);
+    stats.inputBytes = text.size();
+
+    // The tokenizer owns decoded strings, so it has to outlive the parse.
+    Tokenizer tokenizer(text);
+    Tokenizer::TokenVector tokens;
+    {
+        PhaseTimer timer(stats, "tokenize", text.size());
+        tokens = tokenizer.tokenize();
+    }
+    stats.tokens = tokens.size();
+
+    DomBuilder builder;
+    CountingHandler<DomBuilder> counter(builder);
+    {
+        PhaseTimer timer(stats, "parse", text.size());
+        if (!Parser(tokens, text).parse(counter)) {
+            throw ParseException(builder.numberError(text));
+        }
+    }
+    stats.nodes = counter.nodes();
+    stats.maxDepth = counter.maxDepth();
+    return builder.result();
+}
+
+void releaseWithStats(std::shared_ptr<JsonValue>& root, ParseStats& stats) {
+    PhaseTimer timer(stats, "free");
+    root.reset();
+}
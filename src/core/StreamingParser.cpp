@@ -0,0 +1,208 @@
+#include <core/StreamingParser.hpp>
+#include <algorithm>
+#include <utility>
+
+StreamingParser::StreamingParser(ValueCallback onValue) : onValue_(std::move(onValue)) {
+}
+
+void StreamingParser::feed(std::string_view chunk) {
+    if (!pending_.empty()) {
+        const size_t length = completionLength(chunk);
+        if (length == std::string_view::npos) {
+            pending_.append(chunk);
+            return;
+        }
+
+        pending_.append(chunk.substr(0, length));
+        process(pending_, false);
+        consume(pending_);
+        pending_.clear();
+        chunk.remove_prefix(length);
+    }
+
+    const size_t consumed = process(chunk, true);
+    consume(chunk.substr(0, consumed));
+    pending_.assign(chunk.substr(consumed));
+}
+
+void StreamingParser::finish() {
+    if (!pending_.empty()) {
+        process(pending_, false);
+        consume(pending_);
+        pending_.clear();
+    }
+
+    if (!containers_.empty() || state_ != State::Value) {
+        throw ParseException(locate(ParseError{ParseErrorCode::UnexpectedEnd}, {}));
+    }
+}
+
+std::vector<std::shared_ptr<JsonValue>> StreamingParser::takeValues() {
+    std::vector<std::shared_ptr<JsonValue> > values(std::make_move_iterator(values_.begin()),
+                                                    std::make_move_iterator(values_.end()));
+    values_.clear();
+    return values;
+}
+
+size_t StreamingParser::process(const std::string_view input, const bool partial) {
+    tokenizer_.reset(input);
+    tokenizer_.setPartial(partial);
+
+    try {
+        for (Token token = tokenizer_.next(); token.type != TokenType::End; token = tokenizer_.next()) {
+            processToken(token);
+        }
+    } catch (const ParseException& e) {
+        // Offsets are relative to this piece of the stream.
+        throw ParseException(locate(e.error(), input));
+    }
+    return tokenizer_.position();
+}
+
+void StreamingParser::consume(const std::string_view bytes) {
+    for (size_t i = bytes.find('\n'); i != std::string_view::npos; i = bytes.find('\n', i + 1)) {
+        ++line_;
+        lineStart_ = offset_ + i + 1;
+    }
+    offset_ += bytes.size();
+}
+
+ParseError StreamingParser::locate(ParseError error, const std::string_view input) const {
+    const std::string_view before = input.substr(0, std::min(error.offset, input.size()));
+    error.offset += offset_;
+    error.line = line_ + static_cast<uint32_t>(std::ranges::count(before, '\n'));
+    const size_t lineStart = before.rfind('\n');
+    error.column = static_cast<uint32_t>(lineStart == std::string_view::npos ? error.offset - lineStart_ + 1
+                                                                             : before.size() - lineStart);
+    return error;
+}
+
+void StreamingParser::processToken(const Token& token) {
+    switch (state_) {
+        case State::Value:
+            startValue(token);
+            return;
+        case State::FirstElementOrEnd:
+            if (token.type == TokenType::RightBracket) {
+                containers_.pop_back();
+                builder_.onEndArray();
+                afterValue();
+            } else {
+                startValue(token);
+            }
+            return;
+        case State::CommaOrEndArray:
+            if (token.type == TokenType::Comma) {
+                state_ = State::Value;
+            } else if (token.type == TokenType::RightBracket) {
+                containers_.pop_back();
+                builder_.onEndArray();
+                afterValue();
+            } else {
+                fail(ParseErrorCode::ExpectedCommaOrEnd, token.offset);
+            }
+            return;
+        case State::FirstKeyOrEnd:
+            if (token.type == TokenType::RightBrace) {
+                containers_.pop_back();
+                builder_.onEndObject();
+                afterValue();
+                return;
+            }
+            [[fallthrough]];
+        case State::Key:
+            if (token.type != TokenType::String) {
+                fail(ParseErrorCode::ExpectedKey, token.offset);
+            }
+            builder_.onKey(token.value);
+            state_ = State::Colon;
+            return;
+        case State::Colon:
+            if (token.type != TokenType::Colon) {
+                fail(ParseErrorCode::ExpectedColon, token.offset);
+            }
+            state_ = State::Value;
+            return;
+        case State::CommaOrEndObject:
+            if (token.type == TokenType::Comma) {
+                state_ = State::Key;
+            } else if (token.type == TokenType::RightBrace) {
+                containers_.pop_back();
+                builder_.onEndObject();
+                afterValue();
+            } else {
+                fail(ParseErrorCode::ExpectedCommaOrEnd, token.offset);
+            }
+            return;
+    }
+}
+
+void StreamingParser::startValue(const Token& token) {
+    switch (token.type) {
+        case TokenType::LeftBrace:
+            builder_.onStartObject();
+            containers_.push_back(true);
+            state_ = State::FirstKeyOrEnd;
+            return;
+        case TokenType::LeftBracket:
+            builder_.onStartArray();
+            containers_.push_back(false);
+            state_ = State::FirstElementOrEnd;
+            return;
+        case TokenType::String:
+            builder_.onString(token.value);
+            break;
+        case TokenType::Number:
+            if (!builder_.onNumber(token.value)) {
+                fail(ParseErrorCode::NumberOutOfRange, token.offset);
+            }
+            break;
+        case TokenType::Boolean:
+            builder_.onBoolean(token.value == "true");
+            break;
+        case TokenType::Null:
+            builder_.onNull();
+            break;
+        default: fail(ParseErrorCode::UnexpectedToken, token.offset);
+    }
+    afterValue();
+}
+
+void StreamingParser::afterValue() {
+    if (!containers_.empty()) {
+        state_ = containers_.back() ? State::CommaOrEndObject : State::CommaOrEndArray;
+        return;
+    }
+
+    state_ = State::Value;
+    if (onValue_) {
+        onValue_(builder_.result());
+    } else {
+        values_.push_back(builder_.result());
+    }
+}
+
+void StreamingParser::fail(const ParseErrorCode code, const size_t offset) {
+    throw ParseException(ParseError{code, 0, 0, offset});
+}
+
+size_t StreamingParser::completionLength(const std::string_view chunk) const {
+    if (pending_.front() == '"') {
+        bool escaped = false;
+        for (size_t i = 1; i < pending_.size(); ++i) {
+            escaped = !escaped && pending_[i] == '\\';
+        }
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            if (escaped) {
+                escaped = false;
+            } else if (chunk[i] == '\\') {
+                escaped = true;
+            } else if (chunk[i] == '"') {
+                return i + 1;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    return chunk.find_first_not_of("0123456789+-.abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
+}
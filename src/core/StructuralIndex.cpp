@@ -0,0 +1,262 @@
+#include <core/StructuralIndex.hpp>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define JSONPARSER_X86 1
+#endif
+
+namespace {
+    /**
+     * Per-block character classes, one bit per input byte.
+     */
+    struct BlockMasks {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t op;
+        uint64_t whitespace;
+    };
+
+    BlockMasks classifyScalar(const char* block) {
+        BlockMasks masks{};
+        for (int i = 0; i < 64; ++i) {
+            const uint64_t bit = uint64_t{1} << i;
+            switch (block[i]) {
+                case '"': masks.quote |= bit; break;
+                case '\\': masks.backslash |= bit; break;
+                case '{': case '}': case '[': case ']': case ':': case ',': masks.op |= bit; break;
+                case ' ': case '\t': case '\n': case '\r': masks.whitespace |= bit; break;
+                default: break;
+            }
+        }
+        return masks;
+    }
+
+#ifdef JSONPARSER_X86
+    uint64_t movemask16(const __m128i v, const int shift) {
+        return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(v))) << shift;
+    }
+
+    BlockMasks classifySse2(const char* block) {
+        BlockMasks masks{};
+        for (int i = 0; i < 64; i += 16) {
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+            const auto eq = [&](const char c) { return _mm_cmpeq_epi8(in, _mm_set1_epi8(c)); };
+
+            masks.quote |= movemask16(eq('"'), i);
+            masks.backslash |= movemask16(eq('\\'), i);
+            masks.op |= movemask16(_mm_or_si128(_mm_or_si128(_mm_or_si128(eq('{'), eq('}')), _mm_or_si128(eq('['), eq(']'))),
+                                                _mm_or_si128(eq(':'), eq(','))), i);
+            masks.whitespace |= movemask16(_mm_or_si128(_mm_or_si128(eq(' '), eq('\t')), _mm_or_si128(eq('\n'), eq('\r'))), i);
+        }
+        return masks;
+    }
+
+    __attribute__((target("avx2"))) BlockMasks classifyAvx2(const char* block) {
+        BlockMasks masks{};
+        for (int i = 0; i < 64; i += 32) {
+            const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+
+            const __m256i quote = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('"'));
+            const __m256i backslash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('\\'));
+            const __m256i op = _mm256_or_si256(
+                _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('{')),
+                                                _mm256_cmpeq_epi8(in, _mm256_set1_epi8('}'))),
+                                _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('[')),
+                                                _mm256_cmpeq_epi8(in, _mm256_set1_epi8(']')))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8(':')),
+                                _mm256_cmpeq_epi8(in, _mm256_set1_epi8(','))));
+            const __m256i whitespace = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8(' ')),
+                                _mm256_cmpeq_epi8(in, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('\n')),
+                                _mm256_cmpeq_epi8(in, _mm256_set1_epi8('\r'))));
+
+            masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(quote))) << i;
+            masks.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(backslash))) << i;
+            masks.op |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(op))) << i;
+            masks.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(whitespace))) << i;
+        }
+        return masks;
+    }
+#endif
+
+    /**
+     * Bits of characters preceded by an odd number of backslashes. The
+     * carry says whether the first byte of the next block is escaped.
+     */
+    uint64_t escapedMask(uint64_t backslash, uint64_t& carry) {
+        constexpr uint64_t evenBits = 0x5555555555555555ULL;
+
+        backslash &= ~carry;
+        const uint64_t followsEscape = backslash << 1 | carry;
+        const uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+        uint64_t sequencesStartingOnEvenBits;
+        carry = __builtin_add_overflow(oddSequenceStarts, backslash, &sequencesStartingOnEvenBits) ? 1 : 0;
+        const uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+        return (evenBits ^ invertMask) & followsEscape;
+    }
+
+    uint64_t prefixXor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    /**
+     * Classifies the input one 64-byte block at a time, handing the visitor
+     * each block's base offset, its structural bits and the bits of its
+     * operators outside strings.
+     *
+     * @return true if the input ends inside a string.
+     */
+    template<BlockMasks (*Classify)(const char*), typename Visitor>
+    bool scanBlocks(const std::string_view json, Visitor&& visitor) {
+        uint64_t escapeCarry = 0;
+        uint64_t inStringCarry = 0;
+        uint64_t scalarCarry = 0;
+
+        char padded[64];
+        for (size_t base = 0; base < json.size(); base += 64) {
+            const char* block = json.data() + base;
+            const size_t length = json.size() - base;
+            if (length < 64) {
+                std::memset(padded, ' ', sizeof(padded));
+                std::memcpy(padded, block, length);
+                block = padded;
+            }
+
+            const BlockMasks masks = Classify(block);
+
+            const uint64_t escaped = escapedMask(masks.backslash, escapeCarry);
+            const uint64_t quote = masks.quote & ~escaped;
+            const uint64_t inString = prefixXor(quote) ^ inStringCarry;
+            inStringCarry = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+            const uint64_t scalar = ~(masks.op | masks.whitespace | quote);
+            const uint64_t scalarStart = scalar & ~(scalar << 1 | scalarCarry);
+            scalarCarry = scalar >> 63;
+
+            const uint64_t op = masks.op & ~inString;
+            visitor(base, op | (scalarStart & ~inString) | quote, op);
+        }
+
+        return inStringCarry != 0;
+    }
+
+    template<BlockMasks (*Classify)(const char*)>
+    bool buildIndex(const std::string_view json, std::vector<size_t>& positions) {
+        return scanBlocks<Classify>(json, [&](const size_t base, uint64_t structural, uint64_t) {
+            while (structural != 0) {
+                positions.push_back(base + static_cast<size_t>(std::countr_zero(structural)));
+                structural &= structural - 1;
+            }
+        });
+    }
+
+    template<BlockMasks (*Classify)(const char*)>
+    bool findSeparators(const std::string_view json, std::vector<size_t>& separators) {
+        size_t depth = 0;
+        return scanBlocks<Classify>(json, [&](const size_t base, uint64_t, uint64_t op) {
+            while (op != 0) {
+                const size_t position = base + static_cast<size_t>(std::countr_zero(op));
+                op &= op - 1;
+                switch (json[position]) {
+                    case '[': case '{':
+                        if (depth++ == 0) {
+                            separators.push_back(position);
+                        }
+                        break;
+                    case ']': case '}':
+                        if (depth > 0 && --depth == 0) {
+                            separators.push_back(position);
+                        }
+                        break;
+                    case ',':
+                        if (depth == 1) {
+                            separators.push_back(position);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+        });
+    }
+
+    bool cpuSupports(const StructuralIndex::Kernel kernel) {
+        switch (kernel) {
+            case StructuralIndex::Kernel::Scalar:
+                return true;
+#ifdef JSONPARSER_X86
+            case StructuralIndex::Kernel::Sse2:
+                return true;
+            case StructuralIndex::Kernel::Avx2:
+                return __builtin_cpu_supports("avx2");
+#endif
+            default:
+                return false;
+        }
+    }
+}
+
+StructuralIndex::StructuralIndex(const std::string_view json) : StructuralIndex(json, bestKernel()) {
+}
+
+StructuralIndex::StructuralIndex(const std::string_view json, Kernel kernel) {
+    if (!cpuSupports(kernel)) {
+        kernel = bestKernel();
+    }
+
+    positions_.reserve(json.size() / 8 + 16);
+    switch (kernel) {
+#ifdef JSONPARSER_X86
+        case Kernel::Avx2:
+            unterminatedString_ = buildIndex<classifyAvx2>(json, positions_);
+            break;
+        case Kernel::Sse2:
+            unterminatedString_ = buildIndex<classifySse2>(json, positions_);
+            break;
+#endif
+        default:
+            unterminatedString_ = buildIndex<classifyScalar>(json, positions_);
+            break;
+    }
+}
+
+std::vector<size_t> StructuralIndex::topLevelSeparators(const std::string_view json) {
+    std::vector<size_t> separators;
+    switch (bestKernel()) {
+#ifdef JSONPARSER_X86
+        case Kernel::Avx2:
+            findSeparators<classifyAvx2>(json, separators);
+            break;
+        case Kernel::Sse2:
+            findSeparators<classifySse2>(json, separators);
+            break;
+#endif
+        default:
+            findSeparators<classifyScalar>(json, separators);
+            break;
+    }
+    return separators;
+}
+
+StructuralIndex::Kernel StructuralIndex::bestKernel() {
+    static const Kernel kernel = [] {
+        if (cpuSupports(Kernel::Avx2)) {
+            return Kernel::Avx2;
+        }
+        if (cpuSupports(Kernel::Sse2)) {
+            return Kernel::Sse2;
+        }
+        return Kernel::Scalar;
+    }();
+    return kernel;
+}
@@ -0,0 +1,298 @@
+#include <core/Tape.hpp>
+#include <core/MappedFile.hpp>
+#include <core/Number.hpp>
+#include <core/Sax.hpp>
+#include <bit>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    const char* tagName(const TapeTag tag) {
+        switch (tag) {
+            case TapeTag::ObjectStart:
+            case TapeTag::ObjectEnd: return "object";
+            case TapeTag::ArrayStart:
+            case TapeTag::ArrayEnd: return "array";
+            case TapeTag::String: return "string";
+            case TapeTag::Int64:
+            case TapeTag::UInt64:
+            case TapeTag::Double: return "number";
+            case TapeTag::True:
+            case TapeTag::False: return "boolean";
+            case TapeTag::Null: return "null";
+        }
+        return "unknown";
+    }
+
+    /**
+     * A JsonHandler that appends each value to the tape as it is reported.
+     * Only the start words of open containers are remembered; each is
+     * patched with the distance to its end word when the container closes.
+     */
+    class TapeBuilder {
+    public:
+        TapeBuilder(std::vector<uint64_t>& words, std::string& strings) : words_(words), strings_(strings) {
+        }
+
+        bool onStartObject() { return open(TapeTag::ObjectStart); }
+        bool onKey(const std::string_view key) {
+            addString(key);
+            return true;
+        }
+        bool onEndObject() { return close(TapeTag::ObjectEnd); }
+        bool onStartArray() { return open(TapeTag::ArrayStart); }
+        bool onEndArray() { return close(TapeTag::ArrayEnd); }
+
+        bool onString(const std::string_view value) {
+            addString(value);
+            return added();
+        }
+
+        bool onNumber(const std::string_view text) {
+            const std::optional<JsonNumber> number = tryParseJsonNumber(text);
+            if (!number) {
+                numberOutOfRange_ = text.data();
+                return false;
+            }
+
+            if (const auto* integer = std::get_if<int64_t>(&*number)) {
+                words_.push_back(TapeWord::make(TapeTag::Int64));
+                words_.push_back(static_cast<uint64_t>(*integer));
+            } else if (const auto* unsignedInteger = std::get_if<uint64_t>(&*number)) {
+                words_.push_back(TapeWord::make(TapeTag::UInt64));
+                words_.push_back(*unsignedInteger);
+            } else {
+                words_.push_back(TapeWord::make(TapeTag::Double));
+                words_.push_back(std::bit_cast<uint64_t>(std::get<double>(*number)));
+            }
+            return added();
+        }
+
+        bool onBoolean(const bool value) {
+            words_.push_back(TapeWord::make(value ? TapeTag::True : TapeTag::False));
+            return added();
+        }
+
+        bool onNull() {
+            words_.push_back(TapeWord::make(TapeTag::Null));
+            return added();
+        }
+
+        /**
+         * Where the number that stopped the parse starts, or nullptr.
+         */
+        [[nodiscard]] const char* numberOutOfRange() const { return numberOutOfRange_; }
+
+    private:
+        struct Frame {
+            size_t start;
+            size_t count;
+        };
+
+        bool open(const TapeTag tag) {
+            frames_.push_back(Frame{words_.size(), 0});
+            words_.push_back(TapeWord::make(tag));
+            return true;
+        }
+
+        bool close(const TapeTag tag) {
+            const Frame frame = frames_.back();
+            frames_.pop_back();
+            words_[frame.start] |= words_.size() - frame.start;
+            words_.push_back(TapeWord::make(tag, frame.count));
+            return added();
+        }
+
+        void addString(const std::string_view text) {
+            words_.push_back(TapeWord::make(TapeTag::String, strings_.size()));
+            words_.push_back(text.size());
+            strings_.append(text);
+        }
+
+        /**
+         * Counts a finished value towards the size of its container.
+         */
+        bool added() {
+            if (!frames_.empty()) {
+                ++frames_.back().count;
+            }
+            return true;
+        }
+
+        std::vector<uint64_t>& words_;
+        std::string& strings_;
+        std::vector<Frame> frames_;
+        const char* numberOutOfRange_{};
+    };
+}
+
+void TapeRef::throwEmpty() {
+    throw std::runtime_error("Empty value reference");
+}
+
+void TapeRef::throwTypeMismatch(const char* expected) const {
+    throw std::runtime_error(std::string("Expected ") + expected + ", got: " + tagName(tag()));
+}
+
+size_t TapeRef::end(const TapeTag expected) const {
+    if (const TapeTag actual = tag(); actual != expected) {
+        throw std::runtime_error(std::string("Expected ") + tagName(expected) + ", got: " + tagName(actual));
+    }
+    return TapeWord::payload(word());
+}
+
+std::string_view TapeRef::asString() const {
+    if (const TapeTag actual = tag(); actual != TapeTag::String) {
+        throw std::runtime_error(std::string("Expected string, got: ") + tagName(actual));
+    }
+    return text();
+}
+
+int64_t TapeRef::asInt64() const {
+    if (numberType() == NumberType::Int64) {
+        return static_cast<int64_t>(word(1));
+    }
+    throw std::runtime_error("Number is not a 64-bit signed integer");
+}
+
+uint64_t TapeRef::asUInt64() const {
+    const NumberType type = numberType();
+    if (type == NumberType::UInt64 || (type == NumberType::Int64 && static_cast<int64_t>(word(1)) >= 0)) {
+        return word(1);
+    }
+    throw std::runtime_error("Number is not a 64-bit unsigned integer");
+}
+
+NumberType TapeRef::numberType() const {
+    switch (tag()) {
+        case TapeTag::Int64: return NumberType::Int64;
+        case TapeTag::UInt64: return NumberType::UInt64;
+        case TapeTag::Double: return NumberType::Double;
+        default: throw std::runtime_error(std::string("Expected number, got: ") + tagName(tag()));
+    }
+}
+
+bool TapeRef::asBoolean() const {
+    switch (tag()) {
+        case TapeTag::True: return true;
+        case TapeTag::False: return false;
+        default: throw std::runtime_error(std::string("Expected boolean, got: ") + tagName(tag()));
+    }
+}
+
+size_t TapeRef::size() const {
+    switch (tag()) {
+        case TapeTag::ObjectStart:
+        case TapeTag::ArrayStart: return TapeWord::payload(word(TapeWord::payload(word())));
+        default: throw std::runtime_error(std::string("Expected object or array, got: ") + tagName(tag()));
+    }
+}
+
+TapeRef::Range<TapeRef::ElementIterator> TapeRef::elements() const {
+    return {ElementIterator(at(1)), ElementIterator(at(end(TapeTag::ArrayStart)))};
+}
+
+TapeRef::Range<TapeRef::MemberIterator> TapeRef::members() const {
+    return {MemberIterator(at(1)), MemberIterator(at(end(TapeTag::ObjectStart)))};
+}
+
+TapeRef TapeRef::operator[](const size_t index) const {
+    size_t remaining = index;
+    for (const TapeRef element: elements()) {
+        if (remaining-- == 0) {
+            return element;
+        }
+    }
+    throw std::runtime_error("Array index out of range: " + std::to_string(index));
+}
+
+TapeRef TapeRef::operator[](const std::string_view key) const {
+    const TapeRef value = find(key);
+    if (!value) {
+        throw std::runtime_error("Key not found: " + std::string(key));
+    }
+    return value;
+}
+
+TapeRef TapeRef::find(const std::string_view key) const {
+    for (const auto& [name, value]: members()) {
+        if (name == key) {
+            return value;
+        }
+    }
+    return {};
+}
+
+Tape Tape::parse(const std::string_view json) {
+    std::expected<Tape, ParseError> tape = tryParse(json);
+    if (!tape) {
+        throw ParseException(tape.error());
+    }
+    return std::move(*tape);
+}
+
+std::expected<Tape, ParseError> Tape::tryParse(const std::string_view json) noexcept {
+    try {
+        Tape tape;
+        // Start from about the smallest density of real documents and let
+        // the buffers grow: a few doublings cost less than reserving for the
+        // densest case, which would commit several times the input up front.
+        tape.words_.reserve(json.size() / 16 + 4);
+        tape.strings_.reserve(json.size() / 8);
+        TapeBuilder builder(tape.words_, tape.strings_);
+
+        const std::expected<bool, ParseError> complete = tryParseEvents(json, builder);
+        if (!complete) {
+            return std::unexpected(complete.error());
+        }
+        if (!*complete) {
+            const auto offset = static_cast<size_t>(builder.numberOutOfRange() - json.data());
+            return std::unexpected(ParseError{ParseErrorCode::NumberOutOfRange, 0, 0, offset}.locate(json));
+        }
+        return tape;
+    } catch (const std::bad_alloc&) {
+        return std::unexpected(ParseError{ParseErrorCode::OutOfMemory});
+    }
+}
+
+Tape Tape::parseFile(const std::string& path) {
+    const MappedFile file(path);
+    return parse(file.view());
+}
+
+std::shared_ptr<JsonValue> toJsonValue(const TapeRef value) {
+    switch (value.type()) {
+        case DomType::Object: {
+            JsonObject object;
+            for (const auto& [key, member]: value.members()) {
+                object.emplace(std::string(key), toJsonValue(member));
+            }
+            return std::make_shared<JsonValue>(std::move(object));
+        }
+        case DomType::Array: {
+            JsonArray array;
+            array.reserve(value.size());
+            for (const TapeRef element: value.elements()) {
+                array.push_back(toJsonValue(element));
+            }
+            return std::make_shared<JsonValue>(std::move(array));
+        }
+        case DomType::String:
+            return std::make_shared<JsonValue>(std::string(value.asString()));
+        case DomType::Number:
+            switch (value.numberType()) {
+                case NumberType::Int64: return std::make_shared<JsonValue>(value.asInt64());
+                case NumberType::UInt64: return std::make_shared<JsonValue>(value.asUInt64());
+                case NumberType::Double: break;
+            }
+            return std::make_shared<JsonValue>(value.asNumber());
+        case DomType::Boolean:
+            return std::make_shared<JsonValue>(value.asBoolean());
+        case DomType::Null:
+            break;
+    }
+    return std::make_shared<JsonValue>(nullptr);
+}
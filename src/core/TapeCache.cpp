@@ -0,0 +1,220 @@
+#include <core/TapeCache.hpp>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char Magic[8] = {'J', 'S', 'O', 'N', 'T', 'A', 'P', 'E'};
+    constexpr uint32_t Version = 1;
+    constexpr uint32_t ByteOrderMark = 0x01020304;
+
+    /**
+     * The start of an image. It is followed by the tape words, which the
+     * header's size keeps 8-byte aligned, the string buffer and the source
+     * path.
+     */
+    struct ImageHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder; ///< ByteOrderMark as the writing host stored it.
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        uint64_t sourceHash;
+        uint64_t wordCount;
+        uint64_t stringBytes;
+        uint64_t pathBytes;
+    };
+
+    static_assert(sizeof(ImageHeader) % alignof(uint64_t) == 0);
+
+    /**
+     * What an image must have been built from to be used.
+     */
+    struct SourceKey {
+        std::string path;
+        uint64_t size;
+        int64_t time;
+    };
+
+    /**
+     * Checks an image against its source, apart from the content hash.
+     *
+     * @return The header, with words and strings pointing into the image, or
+     * nullopt if it is malformed, foreign or stale.
+     */
+    std::optional<ImageHeader> readImage(const std::string_view image, const SourceKey& key,
+                                         std::span<const uint64_t>& words, std::string_view& strings) {
+        ImageHeader header{};
+        if (image.size() < sizeof(header)) {
+            return std::nullopt;
+        }
+        std::memcpy(&header, image.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version ||
+            header.byteOrder != ByteOrderMark || header.sourceSize != key.size || header.sourceTime != key.time) {
+            return std::nullopt;
+        }
+        // Compare the parts one at a time, as a corrupt header could make
+        // their sum overflow.
+        const uint64_t available = image.size() - sizeof(header);
+        if (header.wordCount == 0 || header.wordCount > available / sizeof(uint64_t) ||
+            header.stringBytes > available - header.wordCount * sizeof(uint64_t) ||
+            header.pathBytes != available - header.wordCount * sizeof(uint64_t) - header.stringBytes) {
+            return std::nullopt;
+        }
+
+        const char* body = image.data() + sizeof(header);
+        const char* text = body + header.wordCount * sizeof(uint64_t);
+        if (std::string_view(text + header.stringBytes, header.pathBytes) != key.path) {
+            return std::nullopt;
+        }
+
+        words = {reinterpret_cast<const uint64_t*>(body), header.wordCount};
+        strings = {text, header.stringBytes};
+        return header;
+    }
+
+    void writeImage(const std::string& path, const SourceKey& key, const uint64_t hash, const Tape& tape) {
+        ImageHeader header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = Version;
+        header.byteOrder = ByteOrderMark;
+        header.sourceSize = key.size;
+        header.sourceTime = key.time;
+        header.sourceHash = hash;
+        header.wordCount = tape.words().size();
+        header.stringBytes = tape.strings().size();
+        header.pathBytes = key.path.size();
+
+        // Write beside the image and rename over it, so that readers see
+        // either the old image or the complete new one.
+        const std::string temporary = path + ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(tape.words().data()),
+                       static_cast<std::streamsize>(tape.words().size_bytes()));
+            file.write(tape.strings().data(), static_cast<std::streamsize>(tape.strings().size()));
+            file.write(key.path.data(), static_cast<std::streamsize>(key.path.size()));
+            if (!file.flush()) {
+                file.close();
+                fs::remove(temporary);
+                throw std::runtime_error("Could not write file: " + temporary);
+            }
+        }
+        fs::rename(temporary, path);
+    }
+}
+
+uint64_t contentHash(const std::string_view bytes) {
+    constexpr uint64_t Multiplier = 0x9e3779b97f4a7c15;
+    constexpr uint64_t Mixer = 0xff51afd7ed558ccd;
+
+    const auto read = [&](const size_t offset) {
+        uint64_t word;
+        std::memcpy(&word, bytes.data() + offset, sizeof(word));
+        return word;
+    };
+    const auto mix = [](const uint64_t hash, const uint64_t word) {
+        return std::rotl(hash ^ word * Mixer, 29) * Multiplier;
+    };
+
+    // Four independent lanes let the multiplications overlap.
+    uint64_t lanes[4] = {bytes.size(), Multiplier, Mixer, ~bytes.size()};
+    size_t i = 0;
+    for (; i + 32 <= bytes.size(); i += 32) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            lanes[lane] = mix(lanes[lane], read(i + lane * 8));
+        }
+    }
+    uint64_t hash = lanes[0] ^ std::rotl(lanes[1], 17) ^ std::rotl(lanes[2], 31) ^ std::rotl(lanes[3], 47);
+    for (; i + 8 <= bytes.size(); i += 8) {
+        hash = mix(hash, read(i));
+    }
+    if (i < bytes.size()) {
+        uint64_t tail = 0;
+        std::memcpy(&tail, bytes.data() + i, bytes.size() - i);
+        hash = mix(hash, tail);
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53;
+    return hash ^ hash >> 33;
+}
+
+CachedTape::CachedTape(Tape tape) : storage_(std::move(tape)) {
+}
+
+CachedTape::CachedTape(MappedFile image, const std::span<const uint64_t> words, const std::string_view strings)
+    : storage_(std::move(image)), words_(words), strings_(strings), fromCache_(true) {
+}
+
+TapeCache::TapeCache(std::string directory, const TapeCacheOptions options)
+    : directory_(std::move(directory)), options_(options) {
+}
+
+std::string TapeCache::imagePath(const std::string& path) const {
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx.tape",
+                  static_cast<unsigned long long>(contentHash(fs::absolute(path).lexically_normal().string())));
+    return (fs::path(directory_) / name).string();
+}
+
+void TapeCache::invalidate(const std::string& path) const {
+    std::error_code error;
+    fs::remove(imagePath(path), error);
+}
+
+CachedTape TapeCache::load(const std::string& path) const {
+    if (!fs::exists(path)) {
+        throw std::runtime_error("File not found: " + path);
+    }
+    if (!fs::is_regular_file(path)) {
+        throw std::runtime_error("Path is not a regular file: " + path);
+    }
+    const SourceKey key{fs::absolute(path).lexically_normal().string(), fs::file_size(path),
+                        static_cast<int64_t>(fs::last_write_time(path).time_since_epoch().count())};
+
+    // The source is only read if the image has to be verified or rebuilt.
+    std::optional<MappedFile> source;
+    std::optional<uint64_t> hash;
+    const auto sourceHash = [&] {
+        if (!hash) {
+            source.emplace(path);
+            hash = contentHash(source->view());
+        }
+        return *hash;
+    };
+
+    const std::string image = imagePath(path);
+    if (std::error_code error; fs::exists(image, error)) {
+        try {
+            MappedFile file(image);
+            std::span<const uint64_t> words;
+            std::string_view strings;
+            if (const std::optional<ImageHeader> header = readImage(file.view(), key, words, strings);
+                header && (!options_.verifyContent || header->sourceHash == sourceHash())) {
+                return CachedTape(std::move(file), words, strings);
+            }
+        } catch (const std::runtime_error&) {
+            // An unreadable image is rebuilt like a stale one.
+        }
+    }
+
+    sourceHash();
+    Tape tape = Tape::parse(source->view());
+    try {
+        fs::create_directories(directory_);
+        writeImage(image, key, *hash, tape);
+    } catch (const std::exception&) {
+        // Failing to cache must not fail the load.
+    }
+    return CachedTape(std::move(tape));
+}
@@ -1,7 +1,23 @@
 #include <core/Tokenizer.hpp>
+#include <core/Number.hpp>
+#include <core/Utf8.hpp>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 namespace {
+    bool isWhiteSpace(const char c) {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+    }
+
+    bool isDigit(const char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    bool isAlpha(const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
     void printTokens(const std::vector<Token>& tokens) {
         for (const auto& token : tokens) {
             std::cout << "Token: Type = " << static_cast<int>(token.type)
@@ -10,50 +26,141 @@ namespace {
     }
 }
 
-Tokenizer::Tokenizer(std::string json) : input{std::move(json)}, currentIndex{0} {
+const char* tokenTypeName(const TokenType type) {
+    switch (type) {
+        case TokenType::LeftBrace: return "'{'";
+        case TokenType::RightBrace: return "'}'";
+        case TokenType::LeftBracket: return "'['";
+        case TokenType::RightBracket: return "']'";
+        case TokenType::Comma: return "','";
+        case TokenType::Colon: return "':'";
+        case TokenType::String: return "string";
+        case TokenType::Number: return "number";
+        case TokenType::Boolean: return "boolean";
+        case TokenType::Null: return "null";
+        case TokenType::Unknown: return "unknown character";
+        case TokenType::End: return "end of input";
+        case TokenType::Error: return "error";
+    }
+    return "unknown";
+}
+
+Tokenizer::Tokenizer(const std::string_view json) : input{json}, currentIndex{0} {
+}
+
+Tokenizer::Tokenizer(const std::string_view json, const StructuralIndex& index)
+    : input{json}, currentIndex{0}, index{&index} {
+}
+
+void Tokenizer::reset(const std::string_view json) {
+    input = json;
+    currentIndex = 0;
+    index = nullptr;
+    indexPosition = 0;
+    failed = false;
+    keepStrings = false;
+    lastError = ParseError{};
+    if (strings) {
+        strings->reset();
+    }
+}
+
+void Tokenizer::reset(const std::string_view json, const StructuralIndex& index) {
+    reset(json);
+    this->index = &index;
 }
 
 Tokenizer::TokenVector Tokenizer::tokenize() {
     TokenVector tokens;
+    tokenize(tokens);
+    return tokens;
+}
 
-    while (currentIndex < input.size()) {
-        this->skipWhiteSpace();
-
-        if (const char c = this->peek(); c == '{') {
-            tokens.emplace_back(TokenType::LeftBrace, "{");
-            this->advance();
-        } else if (c == '}') {
-            tokens.emplace_back(TokenType::RightBrace, "}");
-            this->advance();
-        } else if (c == '[') {
-            tokens.emplace_back(TokenType::LeftBracket, "[");
-            this->advance();
-        } else if (c == ']') {
-            tokens.emplace_back(TokenType::RightBracket, "]");
-            this->advance();
-        } else if (c == ',') {
-            tokens.emplace_back(TokenType::Comma, ",");
-            this->advance();
-        } else if (c == ':') {
-            tokens.emplace_back(TokenType::Colon, ":");
-            this->advance();
-        } else if (c == '"') {
-            tokens.emplace_back(this->parseString());
-        } else if (isdigit(c) || c == '-') {
-            tokens.emplace_back(parseNumber());
-        } else if (isalpha(c)) {
-            tokens.emplace_back(parseKeyword());
-        } else {
-            tokens.emplace_back(TokenType::Unknown, std::string(1, c));
-            this->advance();
-        }
+void Tokenizer::tokenize(TokenVector& tokens) {
+    tokens.clear();
+    keepStrings = true;
+    for (Token token = next(); token.type != TokenType::End && token.type != TokenType::Error; token = next()) {
+        tokens.push_back(token);
     }
+    keepStrings = false;
+}
 
-    return tokens;
+Token Tokenizer::next() {
+    if (failed) {
+        return Token(TokenType::Error, {}, lastError.offset);
+    }
+    if (index != nullptr) {
+        return nextIndexed();
+    }
+
+    this->skipWhiteSpace();
+    if (currentIndex == input.size()) {
+        return Token(TokenType::End, {}, currentIndex);
+    }
+
+    return nextToken();
+}
+
+Token Tokenizer::nextIndexed() {
+    const auto& positions = index->positions();
+    while (indexPosition < positions.size() && positions[indexPosition] < currentIndex) {
+        ++indexPosition;
+    }
+
+    // Scalar tokens end at the first byte that cannot continue them. Anything
+    // glued to them that is not whitespace was never indexed, so hand it to
+    // the byte-wise path, which reports it the same way it would unindexed.
+    if (const size_t next = indexPosition < positions.size() ? positions[indexPosition] : input.size();
+        currentIndex < next && !isWhiteSpace(input[currentIndex])) {
+        return nextToken();
+    }
+
+    if (indexPosition == positions.size()) {
+        currentIndex = input.size();
+        return Token(TokenType::End, {}, currentIndex);
+    }
+
+    // Strings are scanned rather than cut at the indexed closing quote, so
+    // their contents are checked the same way on both paths. Index entries
+    // inside the scanned range are skipped on the next call.
+    currentIndex = positions[indexPosition++];
+    return nextToken();
+}
+
+Token Tokenizer::nextToken() {
+    const size_t start = currentIndex;
+    if (const char c = this->peek(); c == '{') {
+        this->advance();
+        return Token(TokenType::LeftBrace, input.substr(start, 1), start);
+    } else if (c == '}') {
+        this->advance();
+        return Token(TokenType::RightBrace, input.substr(start, 1), start);
+    } else if (c == '[') {
+        this->advance();
+        return Token(TokenType::LeftBracket, input.substr(start, 1), start);
+    } else if (c == ']') {
+        this->advance();
+        return Token(TokenType::RightBracket, input.substr(start, 1), start);
+    } else if (c == ',') {
+        this->advance();
+        return Token(TokenType::Comma, input.substr(start, 1), start);
+    } else if (c == ':') {
+        this->advance();
+        return Token(TokenType::Colon, input.substr(start, 1), start);
+    } else if (c == '"') {
+        return this->parseString();
+    } else if (isDigit(c) || c == '-') {
+        return parseNumber();
+    } else if (isAlpha(c)) {
+        return parseKeyword();
+    } else {
+        this->advance();
+        return Token(TokenType::Unknown, input.substr(start, 1), start);
+    }
 }
 
 char Tokenizer::peek() const {
-    return this->input[currentIndex];
+    return currentIndex < input.size() ? this->input[currentIndex] : '\0';
 }
 
 char Tokenizer::advance() {
@@ -61,45 +168,126 @@ char Tokenizer::advance() {
 }
 
 void Tokenizer::skipWhiteSpace() {
-    while (currentIndex < input.size() && isspace(input[currentIndex])) {
+    while (currentIndex < input.size() && isWhiteSpace(input[currentIndex])) {
         ++currentIndex;
     }
 }
 
 Token Tokenizer::parseString() {
-    std::string result;
-    advance();
-    while (currentIndex < input.size() && peek() != '"') {
-        result += advance();
+    const size_t tokenStart = currentIndex;
+    const size_t start = tokenStart + 1;
+    size_t i = start;
+    bool escaped = false;
+
+    while (true) {
+        i += stringContentPrefix(input.substr(i));
+        if (i == input.size()) {
+            if (partial) {
+                return cutToken(tokenStart);
+            }
+            return fail(ParseErrorCode::UnterminatedString, tokenStart);
+        }
+
+        const auto c = static_cast<unsigned char>(input[i]);
+        if (c == '"') {
+            break;
+        }
+
+        size_t length;
+        ParseErrorCode code;
+        if (c == '\\') {
+            length = escapeLength(input.substr(i));
+            code = ParseErrorCode::InvalidEscape;
+            escaped = true;
+        } else if (c < 0x20) {
+            length = 0;
+            code = ParseErrorCode::ControlCharacter;
+        } else {
+            length = utf8SequenceLength(input.substr(i));
+            code = ParseErrorCode::InvalidUtf8;
+        }
+
+        if (length == 0) {
+            // An escape (up to a 12-byte surrogate pair) or multi-byte sequence
+            // may just be cut by the end of a partial input.
+            if (partial && input.size() - i < 12 && c >= 0x20) {
+                return cutToken(tokenStart);
+            }
+            return fail(code, i);
+        }
+        i += length;
     }
-    if (currentIndex == input.size() || peek() != '"') {
-        throw std::runtime_error("Unterminated string");
+
+    currentIndex = i + 1;
+    const std::string_view raw = input.substr(start, i - start);
+    if (!escaped || !decodeEscapes) {
+        return Token(TokenType::String, raw, tokenStart);
+    }
+
+    char* decoded;
+    if (keepStrings) {
+        if (!strings) {
+            strings = std::make_unique<Arena>(StringBlockSize);
+        }
+        decoded = static_cast<char*>(strings->allocate(raw.size(), 1));
+    } else {
+        // Decoding only ever shortens the text.
+        std::string& buffer = scratch[scratchTurn];
+        scratchTurn = !scratchTurn;
+        if (buffer.size() < raw.size()) {
+            buffer.resize(raw.size());
+        }
+        decoded = buffer.data();
     }
-    advance();
-    return Token(TokenType::String, result);
+    return Token(TokenType::String, std::string_view(decoded, unescapeString(raw, decoded)), tokenStart);
 }
 
 Token Tokenizer::parseNumber() {
-    std::string result;
-    while (currentIndex < input.size() && (isdigit(peek()) || peek() == '-' || peek() == '.' || peek() == 'e' || peek() == 'E')) {
-        result += advance();
+    const size_t start = currentIndex;
+    currentIndex += scanNumber(input.substr(start));
+    if (partial && currentIndex == input.size()) {
+        return cutToken(start);
+    }
+
+    const std::string_view result = input.substr(start, currentIndex - start);
+    if (!isJsonNumber(result)) {
+        return fail(ParseErrorCode::InvalidNumber, start);
     }
 
-    return Token(TokenType::Number, result);
+    return Token(TokenType::Number, result, start);
 }
 
 Token Tokenizer::parseKeyword() {
-    std::string result;
+    const size_t start = currentIndex;
 
-    while (currentIndex < input.size() && isalpha(peek())) {
-        result += advance();
+    while (currentIndex < input.size() && isAlpha(peek())) {
+        ++currentIndex;
+    }
+    if (partial && currentIndex == input.size()) {
+        return cutToken(start);
     }
 
+    const std::string_view result = input.substr(start, currentIndex - start);
     if (result == "true" || result == "false") {
-        return Token(TokenType::Boolean, result);
+        return Token(TokenType::Boolean, result, start);
     } else if (result == "null") {
-        return Token(TokenType::Null, result);
+        return Token(TokenType::Null, result, start);
     } else {
-        throw std::runtime_error("Invalid keyword: " + result);
+        return fail(ParseErrorCode::InvalidKeyword, start);
+    }
+}
+
+Token Tokenizer::cutToken(const size_t start) {
+    currentIndex = start;
+    return Token(TokenType::End, {}, start);
+}
+
+Token Tokenizer::fail(const ParseErrorCode code, const size_t offset) {
+    lastError = ParseError{code, 0, 0, offset};
+    if (!recordErrors) {
+        throw ParseException(lastError.locate(input));
     }
+    failed = true;
+    currentIndex = input.size();
+    return Token(TokenType::Error, {}, offset);
 }
@@ -0,0 +1,396 @@
+#include <core/Utf8.hpp>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define JSONPARSER_X86 1
+#endif
+
+namespace {
+    bool isPlain(const unsigned char c) {
+        return c >= 0x20 && c < 0x80 && c != '"' && c != '\\';
+    }
+
+    bool isHexDigit(const char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    bool isContinuation(const unsigned char c) {
+        return (c & 0xC0) == 0x80;
+    }
+
+    uint32_t hexValue(const char c) {
+        if (c <= '9') {
+            return static_cast<uint32_t>(c - '0');
+        }
+        return static_cast<uint32_t>((c | 0x20) - 'a' + 10);
+    }
+
+    /**
+     * Reads the four hex digits of a \uXXXX escape at the start of the text.
+     */
+    bool readUnicodeEscape(const std::string_view text, uint32_t& unit) {
+        if (text.size() < 6 || text[0] != '\\' || text[1] != 'u') {
+            return false;
+        }
+        unit = 0;
+        for (size_t i = 2; i < 6; ++i) {
+            if (!isHexDigit(text[i])) {
+                return false;
+            }
+            unit = unit << 4 | hexValue(text[i]);
+        }
+        return true;
+    }
+
+    /**
+     * Parses the escape sequence at the start of the text into the code
+     * point it stands for. A high surrogate must be followed by a \u escape
+     * of a low surrogate, and the pair stands for one code point; unpaired
+     * surrogates have no UTF-8 form and are rejected.
+     *
+     * @return The length of the sequence, or 0 if it is invalid.
+     */
+    size_t parseEscape(const std::string_view text, uint32_t& codePoint) {
+        if (text.size() < 2) {
+            return 0;
+        }
+        switch (text[1]) {
+            case '"': codePoint = '"'; return 2;
+            case '\\': codePoint = '\\'; return 2;
+            case '/': codePoint = '/'; return 2;
+            case 'b': codePoint = '\b'; return 2;
+            case 'f': codePoint = '\f'; return 2;
+            case 'n': codePoint = '\n'; return 2;
+            case 'r': codePoint = '\r'; return 2;
+            case 't': codePoint = '\t'; return 2;
+            case 'u': break;
+            default: return 0;
+        }
+
+        uint32_t high;
+        if (!readUnicodeEscape(text, high) || (high >= 0xDC00 && high <= 0xDFFF)) {
+            return 0;
+        }
+        if (high < 0xD800 || high > 0xDBFF) {
+            codePoint = high;
+            return 6;
+        }
+
+        uint32_t low;
+        if (!readUnicodeEscape(text.substr(6), low) || low < 0xDC00 || low > 0xDFFF) {
+            return 0;
+        }
+        codePoint = 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+        return 12;
+    }
+
+    size_t encodeUtf8(const uint32_t codePoint, char* out) {
+        if (codePoint < 0x80) {
+            out[0] = static_cast<char>(codePoint);
+            return 1;
+        }
+        if (codePoint < 0x800) {
+            out[0] = static_cast<char>(0xC0 | codePoint >> 6);
+            out[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+            return 2;
+        }
+        if (codePoint < 0x10000) {
+            out[0] = static_cast<char>(0xE0 | codePoint >> 12);
+            out[1] = static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+            out[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+            return 3;
+        }
+        out[0] = static_cast<char>(0xF0 | codePoint >> 18);
+        out[1] = static_cast<char>(0x80 | (codePoint >> 12 & 0x3F));
+        out[2] = static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+        out[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 4;
+    }
+
+#ifdef JSONPARSER_X86
+    /**
+     * Scans 32 bytes at a time and stops at the block holding the first
+     * special byte, or when fewer than 32 bytes are left.
+     */
+    __attribute__((target("avx2"))) size_t plainPrefixAvx2(const std::string_view text) {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i space = _mm256_set1_epi8(0x20);
+        size_t i = 0;
+        for (; i + 32 <= text.size(); i += 32) {
+            const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + i));
+            const __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(in, quote), _mm256_cmpeq_epi8(in, backslash)),
+                _mm256_cmpgt_epi8(space, in));
+            if (const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(special)); mask != 0) {
+                return i + static_cast<size_t>(std::countr_zero(mask));
+            }
+        }
+        return i;
+    }
+
+    /**
+     * The start of the sequence cut by position i, or i itself if the text
+     * before it ends with a complete sequence (or is not UTF-8 at all).
+     */
+    size_t sequenceBoundary(const std::string_view text, const size_t i) {
+        size_t lead = i;
+        while (lead > 0 && i - lead < 3 && isContinuation(static_cast<unsigned char>(text[lead - 1]))) {
+            --lead;
+        }
+        if (lead == 0 || static_cast<unsigned char>(text[lead - 1]) < 0xC0) {
+            return i;
+        }
+        --lead;
+        const auto c = static_cast<unsigned char>(text[lead]);
+        const size_t length = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : 2;
+        return i - lead < length ? lead : i;
+    }
+
+    /**
+     * The bytes of the previous block and this one, shifted so that each
+     * byte lines up with the one n places before it.
+     */
+    template<int N>
+    __attribute__((target("avx2"))) __m256i previous(const __m256i in, const __m256i prior) {
+        return _mm256_alignr_epi8(in, _mm256_permute2x128_si256(prior, in, 0x21), 16 - N);
+    }
+
+    __attribute__((target("avx2"))) __m256i lookup(const __m256i table, const __m256i nibbles) {
+        return _mm256_shuffle_epi8(table, nibbles);
+    }
+
+    /**
+     * Flags the bytes of a block that make the UTF-8 invalid, given the
+     * block before it, using the lookup tables of Keiser and Lemire
+     * ("Validating UTF-8 In Less Than One Instruction Per Byte", 2021). Each
+     * error class is a bit: the three tables, indexed by the nibbles of a
+     * byte and the one before it, must agree on a bit for the pair to be an
+     * error. Continuations owed to a 3- or 4-byte lead are checked apart.
+     */
+    __attribute__((target("avx2"))) __m256i utf8Errors(const __m256i in, const __m256i prior) {
+        constexpr char TooShort = 1 << 0;
+        constexpr char TooLong = 1 << 1;
+        constexpr char Overlong3 = 1 << 2;
+        constexpr char TooLarge = 1 << 3;
+        constexpr char Surrogate = 1 << 4;
+        constexpr char Overlong2 = 1 << 5;
+        constexpr char TooLarge1000 = 1 << 6;
+        constexpr char Overlong4 = 1 << 6;
+        constexpr char TwoConts = static_cast<char>(1 << 7);
+        constexpr char Carry = TooShort | TooLong | TwoConts;
+
+        const __m256i byte1HighTable = _mm256_setr_epi8(
+            TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+            TwoConts, TwoConts, TwoConts, TwoConts,
+            TooShort | Overlong2, TooShort, TooShort | Overlong3 | Surrogate,
+            TooShort | TooLarge | TooLarge1000 | Overlong4,
+            TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+            TwoConts, TwoConts, TwoConts, TwoConts,
+            TooShort | Overlong2, TooShort, TooShort | Overlong3 | Surrogate,
+            TooShort | TooLarge | TooLarge1000 | Overlong4);
+        constexpr char Large = Carry | TooLarge | TooLarge1000;
+        const __m256i byte1LowTable = _mm256_setr_epi8(
+            Carry | Overlong3 | Overlong2 | Overlong4, Carry | Overlong2, Carry, Carry,
+            Carry | TooLarge, Large, Large, Large, Large, Large, Large, Large, Large, Large | Surrogate, Large, Large,
+            Carry | Overlong3 | Overlong2 | Overlong4, Carry | Overlong2, Carry, Carry,
+            Carry | TooLarge, Large, Large, Large, Large, Large, Large, Large, Large, Large | Surrogate, Large, Large);
+        constexpr char Cont1000 = TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4;
+        constexpr char Cont1001 = TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge;
+        constexpr char Cont101 = TooLong | Overlong2 | TwoConts | Surrogate | TooLarge;
+        const __m256i byte2HighTable = _mm256_setr_epi8(
+            TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+            Cont1000, Cont1001, Cont101, Cont101, TooShort, TooShort, TooShort, TooShort,
+            TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+            Cont1000, Cont1001, Cont101, Cont101, TooShort, TooShort, TooShort, TooShort);
+
+        const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+        const __m256i prev1 = previous<1>(in, prior);
+        const __m256i byte1High = lookup(byte1HighTable, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibble));
+        const __m256i byte1Low = lookup(byte1LowTable, _mm256_and_si256(prev1, lowNibble));
+        const __m256i byte2High = lookup(byte2HighTable, _mm256_and_si256(_mm256_srli_epi16(in, 4), lowNibble));
+        const __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+        // Only a byte two places after a 111_____ lead, or three after a
+        // 1111____ one, comes out at 0x80 or above.
+        const __m256i third = _mm256_subs_epu8(previous<2>(in, prior), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+        const __m256i fourth = _mm256_subs_epu8(previous<3>(in, prior), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+        const __m256i owed = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+        return _mm256_xor_si256(owed, special);
+    }
+
+    /**
+     * Scans 32 bytes at a time for the end of valid string contents. A block
+     * of ASCII after a complete sequence only needs the special-byte check.
+     *
+     * @return The exact position of a quote, backslash or control character
+     * with nothing invalid before it; otherwise a sequence boundary in front
+     * of the problem (or of the last, partial block) to continue from.
+     */
+    __attribute__((target("avx2"))) size_t contentPrefixAvx2(const std::string_view text) {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x1F);
+        // Non-zero after subtracting where a lead still owes bytes at the end.
+        const __m256i incompleteMax = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+
+        __m256i prior = _mm256_setzero_si256();
+        bool incomplete = false;
+        size_t i = 0;
+        for (; i + 32 <= text.size(); i += 32) {
+            const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + i));
+            const __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(in, quote), _mm256_cmpeq_epi8(in, backslash)),
+                _mm256_cmpeq_epi8(_mm256_min_epu8(in, control), in));
+            const auto specialMask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+
+            uint32_t errorMask = 0;
+            if (incomplete || _mm256_movemask_epi8(in) != 0) {
+                const __m256i errors = utf8Errors(in, prior);
+                errorMask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(errors, _mm256_setzero_si256())));
+                incomplete = !_mm256_testz_si256(_mm256_subs_epu8(in, incompleteMax), _mm256_subs_epu8(in, incompleteMax));
+            }
+
+            if ((specialMask | errorMask) != 0) {
+                // An error owed to the bytes before a special byte is flagged
+                // at its position at the latest.
+                if (specialMask != 0 && std::countr_zero(specialMask) < std::countr_zero(errorMask)) {
+                    return i + static_cast<size_t>(std::countr_zero(specialMask));
+                }
+                return sequenceBoundary(text, i);
+            }
+            prior = in;
+        }
+        return sequenceBoundary(text, i);
+    }
+#endif
+}
+
+size_t plainStringPrefix(const std::string_view text) {
+    size_t i = 0;
+#ifdef JSONPARSER_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2 && text.size() >= 32) {
+        i = plainPrefixAvx2(text);
+    }
+
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    // Signed comparison: bytes >= 0x80 are negative, so one compare catches both
+    // control characters and non-ASCII bytes.
+    const __m128i space = _mm_set1_epi8(0x20);
+    for (; i + 16 <= text.size(); i += 16) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+        const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(in, quote), _mm_cmpeq_epi8(in, backslash)),
+                                             _mm_cmpgt_epi8(space, in));
+        if (const int mask = _mm_movemask_epi8(special); mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+        }
+    }
+#endif
+    while (i < text.size() && isPlain(static_cast<unsigned char>(text[i]))) {
+        ++i;
+    }
+    return i;
+}
+
+size_t utf8SequenceLength(const std::string_view text) {
+    if (text.empty()) {
+        return 0;
+    }
+
+    const auto byte = [&](const size_t i) { return static_cast<unsigned char>(text[i]); };
+    const unsigned char lead = byte(0);
+    if (lead < 0x80) {
+        return 1;
+    }
+
+    // Ranges of the second byte come from the table of well-formed sequences
+    // in the Unicode standard (section 3.9); they exclude overlong forms,
+    // surrogates and code points above U+10FFFF.
+    size_t length;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        low = lead == 0xE0 ? 0xA0 : 0x80;
+        high = lead == 0xED ? 0x9F : 0xBF;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        low = lead == 0xF0 ? 0x90 : 0x80;
+        high = lead == 0xF4 ? 0x8F : 0xBF;
+    } else {
+        return 0;
+    }
+
+    if (text.size() < length || byte(1) < low || byte(1) > high) {
+        return 0;
+    }
+    for (size_t i = 2; i < length; ++i) {
+        if (!isContinuation(byte(i))) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+size_t stringContentPrefix(const std::string_view text) {
+    size_t i = 0;
+#ifdef JSONPARSER_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2 && text.size() >= 32) {
+        i = contentPrefixAvx2(text);
+    }
+#endif
+    while (i < text.size()) {
+        if (const auto c = static_cast<unsigned char>(text[i]); c < 0x80) {
+            if (!isPlain(c)) {
+                break;
+            }
+            i += plainStringPrefix(text.substr(i));
+        } else if (const size_t length = utf8SequenceLength(text.substr(i)); length > 0) {
+            i += length;
+        } else {
+            break;
+        }
+    }
+    return i;
+}
+
+size_t escapeLength(const std::string_view text) {
+    uint32_t codePoint;
+    return parseEscape(text, codePoint);
+}
+
+size_t unescapeString(const std::string_view raw, char* out) {
+    size_t written = 0;
+    size_t i = 0;
+    while (i < raw.size()) {
+        size_t run = raw.find('\\', i);
+        if (run == std::string_view::npos) {
+            run = raw.size();
+        }
+        std::memcpy(out + written, raw.data() + i, run - i);
+        written += run - i;
+        if (run == raw.size()) {
+            break;
+        }
+
+        uint32_t codePoint;
+        const size_t length = parseEscape(raw.substr(run), codePoint);
+        if (length == 0) {
+            return std::string_view::npos;
+        }
+        written += encodeUtf8(codePoint, out + written);
+        i = run + length;
+    }
+    return written;
+}
@@ -0,0 +1,12 @@
+#include <core/Validate.hpp>
+#include <core/Sax.hpp>
+
+std::expected<void, ParseError> validate(const std::string_view json) noexcept {
+    Tokenizer tokenizer(json);
+    tokenizer.setDecodeEscapes(false);
+    NullHandler handler;
+    if (const std::expected<bool, ParseError> complete = tryParseEvents(tokenizer, handler); !complete) {
+        return std::unexpected(complete.error());
+    }
+    return {};
+}
@@ -0,0 +1,39 @@
+#include <core/WorkerPool.hpp>
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this] { run(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    queued_.release(static_cast<std::ptrdiff_t>(workers_.size()));
+
+    for (auto& worker: workers_) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run() {
+    while (true) {
+        std::function<void()> task;
+        queued_.acquire();
+        {
+            std::lock_guard lock(mutex_);
+            // Every task has a release of its own, so finding the queue
+            // empty means this release was the destructor's.
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,346 @@
+#include <core/Writer.hpp>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define JSONPARSER_SSE2 1
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+    bool needsEscape(const unsigned char c) {
+        return c < 0x20 || c == '"' || c == '\\';
+    }
+
+    /**
+     * Length of the prefix that can be copied without escaping.
+     */
+    size_t cleanPrefix(const std::string_view text) {
+        size_t i = 0;
+#ifdef JSONPARSER_SSE2
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1F);
+        for (; i + 16 <= text.size(); i += 16) {
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+            const __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(in, quote), _mm_cmpeq_epi8(in, backslash)),
+                _mm_cmpeq_epi8(_mm_min_epu8(in, control), in));
+            if (const int mask = _mm_movemask_epi8(special); mask != 0) {
+                return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+            }
+        }
+#endif
+        while (i < text.size() && !needsEscape(static_cast<unsigned char>(text[i]))) {
+            ++i;
+        }
+        return i;
+    }
+}
+
+JsonWriter::JsonWriter(const WriteOptions options) : JsonWriter(Sink::Buffer, nullptr, -1, options) {
+}
+
+JsonWriter::JsonWriter(const Sink sink, std::FILE* file, const int fd, const WriteOptions options)
+    : sink_(sink), file_(file), fd_(fd), options_(options) {
+    if (sink_ != Sink::Buffer) {
+        buffer_.reserve(FlushThreshold + 4096);
+    }
+}
+
+JsonWriter JsonWriter::toFile(std::FILE* file, const WriteOptions options) {
+    return {Sink::File, file, -1, options};
+}
+
+JsonWriter JsonWriter::toDescriptor(const int fd, const WriteOptions options) {
+    return {Sink::Descriptor, nullptr, fd, options};
+}
+
+JsonWriter::JsonWriter(JsonWriter&& other) noexcept
+    : sink_(other.sink_), file_(other.file_), fd_(other.fd_), options_(other.options_),
+      buffer_(std::move(other.buffer_)), first_(std::move(other.first_)), afterKey_(other.afterKey_),
+      wroteRoot_(other.wroteRoot_) {
+    other.sink_ = Sink::Buffer;
+}
+
+JsonWriter::~JsonWriter() {
+    try {
+        flush();
+    } catch (const std::runtime_error&) {
+    }
+}
+
+void JsonWriter::write(const JsonValue& value) {
+    std::visit(
+        [&]<typename T0>(const T0& val) {
+            using T = std::decay_t<T0>;
+
+            if constexpr (std::is_same_v<T, JsonObject>) {
+                onStartObject();
+                for (const auto& [key, objVal]: val) {
+                    onKey(key);
+                    write(*objVal);
+                }
+                onEndObject();
+            } else if constexpr (std::is_same_v<T, JsonArray>) {
+                onStartArray();
+                for (const auto& arrVal: val) {
+                    write(*arrVal);
+                }
+                onEndArray();
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                onString(val);
+            } else if constexpr (std::is_same_v<T, bool>) {
+                onBoolean(val);
+            } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                onNull();
+            } else {
+                writeNumber(val);
+            }
+        },
+        value.value());
+}
+
+void JsonWriter::write(const ValueRef value) {
+    switch (value.type()) {
+        case DomType::Object:
+            onStartObject();
+            for (const DomMember& member: value.members()) {
+                onKey(member.key());
+                write(member.value);
+            }
+            onEndObject();
+            return;
+        case DomType::Array:
+            onStartArray();
+            for (const DomNode& element: value.elements()) {
+                write(element);
+            }
+            onEndArray();
+            return;
+        case DomType::String:
+            onString(value.asString());
+            return;
+        case DomType::Number:
+            switch (value.numberType()) {
+                case NumberType::Int64: writeNumber(value.asInt64()); return;
+                case NumberType::UInt64: writeNumber(value.asUInt64()); return;
+                case NumberType::Double: writeNumber(value.asNumber()); return;
+            }
+            return;
+        case DomType::Boolean:
+            onBoolean(value.asBoolean());
+            return;
+        case DomType::Null:
+            onNull();
+            return;
+    }
+}
+
+bool JsonWriter::onStartObject() {
+    beforeValue();
+    buffer_ += '{';
+    first_.push_back(true);
+    return true;
+}
+
+bool JsonWriter::onKey(const std::string_view key) {
+    beforeValue();
+    writeString(key);
+    buffer_ += options_.pretty ? ": " : ":";
+    afterKey_ = true;
+    maybeFlush();
+    return true;
+}
+
+bool JsonWriter::onEndObject() {
+    const bool empty = first_.back();
+    first_.pop_back();
+    if (!empty) {
+        newline();
+    }
+    buffer_ += '}';
+    maybeFlush();
+    return true;
+}
+
+bool JsonWriter::onStartArray() {
+    beforeValue();
+    buffer_ += '[';
+    first_.push_back(true);
+    return true;
+}
+
+bool JsonWriter::onEndArray() {
+    const bool empty = first_.back();
+    first_.pop_back();
+    if (!empty) {
+        newline();
+    }
+    buffer_ += ']';
+    maybeFlush();
+    return true;
+}
+
+bool JsonWriter::onString(const std::string_view value) {
+    beforeValue();
+    writeString(value);
+    maybeFlush();
+    return true;
+}
+
+bool JsonWriter::onNumber(const std::string_view text) {
+    beforeValue();
+    buffer_ += text;
+    maybeFlush();
+    return true;
+}
+
+bool JsonWriter::onBoolean(const bool value) {
+    beforeValue();
+    buffer_ += value ? "true" : "false";
+    maybeFlush();
+    return true;
+}
+
+bool JsonWriter::onNull() {
+    beforeValue();
+    buffer_ += "null";
+    maybeFlush();
+    return true;
+}
+
+void JsonWriter::writeNumber(const int64_t value) {
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    onNumber({digits, static_cast<size_t>(result.ptr - digits)});
+}
+
+void JsonWriter::writeNumber(const uint64_t value) {
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    onNumber({digits, static_cast<size_t>(result.ptr - digits)});
+}
+
+void JsonWriter::writeNumber(const double value) {
+    if (!std::isfinite(value)) {
+        onNull();
+        return;
+    }
+
+    char digits[40];
+    char* end = std::to_chars(digits, digits + sizeof(digits) - 2, value).ptr;
+    if (std::string_view(digits, static_cast<size_t>(end - digits)).find_first_of(".e") == std::string_view::npos) {
+        // Keep integral doubles recognizable as doubles when read back.
+        *end++ = '.';
+        *end++ = '0';
+    }
+    onNumber({digits, static_cast<size_t>(end - digits)});
+}
+
+void JsonWriter::flush() {
+    if (buffer_.empty() || sink_ == Sink::Buffer) {
+        return;
+    }
+
+    if (sink_ == Sink::File) {
+        if (std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) {
+            throw std::runtime_error("Failed to write output");
+        }
+    } else {
+#if defined(__unix__) || defined(__APPLE__)
+        for (size_t done = 0; done < buffer_.size();) {
+            const ssize_t n = ::write(fd_, buffer_.data() + done, buffer_.size() - done);
+            if (n < 0) {
+                throw std::runtime_error("Failed to write output");
+            }
+            done += static_cast<size_t>(n);
+        }
+#else
+        throw std::runtime_error("File descriptor output is not supported on this platform");
+#endif
+    }
+    buffer_.clear();
+}
+
+std::string JsonWriter::take() {
+    std::string output = std::move(buffer_);
+    buffer_.clear();
+    return output;
+}
+
+void JsonWriter::beforeValue() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+
+    if (first_.empty()) {
+        if (wroteRoot_) {
+            buffer_ += '\n';
+        }
+        wroteRoot_ = true;
+        return;
+    }
+
+    if (!first_.back()) {
+        buffer_ += ',';
+    }
+    first_.back() = false;
+    newline();
+}
+
+void JsonWriter::newline() {
+    if (options_.pretty) {
+        buffer_ += '\n';
+        buffer_.append(first_.size() * static_cast<size_t>(options_.indent), ' ');
+    }
+}
+
+void JsonWriter::writeString(std::string_view value) {
+    static constexpr char hex[] = "0123456789abcdef";
+
+    buffer_ += '"';
+    while (!value.empty()) {
+        const size_t clean = cleanPrefix(value);
+        buffer_.append(value.data(), clean);
+        if (clean == value.size()) {
+            break;
+        }
+
+        switch (const auto c = static_cast<unsigned char>(value[clean])) {
+            case '"': buffer_ += "\\\""; break;
+            case '\\': buffer_ += "\\\\"; break;
+            case '\b': buffer_ += "\\b"; break;
+            case '\f': buffer_ += "\\f"; break;
+            case '\n': buffer_ += "\\n"; break;
+            case '\r': buffer_ += "\\r"; break;
+            case '\t': buffer_ += "\\t"; break;
+            default:
+                buffer_ += "\\u00";
+                buffer_ += hex[c >> 4];
+                buffer_ += hex[c & 0xF];
+                break;
+        }
+        value.remove_prefix(clean + 1);
+    }
+    buffer_ += '"';
+}
+
+void JsonWriter::maybeFlush() {
+    if (sink_ != Sink::Buffer && buffer_.size() >= FlushThreshold) {
+        flush();
+    }
+}
+
+std::string toJson(const JsonValue& value, const WriteOptions& options) {
+    JsonWriter writer(options);
+    writer.write(value);
+    return writer.take();
+}
@@ -1,57 +1,115 @@
+#include <cstdio>
 #include <iostream>
+#include <core/JsonPath.hpp>
+#include <core/MappedFile.hpp>
+#include <core/Ndjson.hpp>
+#include <core/ParallelArray.hpp>
 #include <core/Parser.hpp>
-
-namespace {
-    void printJson(const std::shared_ptr<JsonValue> &value, const int indent = 0) {
-        const std::string padding(indent, ' ');
-
-        std::visit(
-            [&]<typename T0>(const T0 &val) {
-                using T = std::decay_t<T0>;
-
-                if constexpr (std::is_same_v<T, JsonObject>) {
-                    std::cout << padding << "{\n";
-                    for (const auto &[key, objVal]: val) {
-                        std::cout << padding << "  \"" << key << "\": ";
-                        printJson(objVal, indent + 2);
-                    }
-                    std::cout << padding << "}\n";
-                } else if constexpr (std::is_same_v<T, JsonArray>) {
-                    std::cout << padding << "[\n";
-                    for (const auto &arrVal: val) {
-                        printJson(arrVal, indent + 2);
-                    }
-                    std::cout << padding << "]\n";
-                } else if constexpr (std::is_same_v<T, std::string>) {
-                    std::cout << "\"" << val << "\"\n";
-                } else if constexpr (std::is_same_v<T, double>) {
-                    std::cout << val << "\n";
-                } else if constexpr (std::is_same_v<T, bool>) {
-                    std::cout << (val ? "true" : "false") << "\n";
-                } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
-                    std::cout << "null\n";
-                }
-            },
-            value->value()
-        );
-    }
-}
+#include <core/Stats.hpp>
+#include <core/Writer.hpp>
 
 int main(const int argc, char* argv[]) {
     try {
         if (argc < 2) {
-            std::cerr << "Usage: " << argv[0] << " <json_string_or_file_path> [--file]\n";
+            std::cerr << "Usage: " << argv[0] << " <json_string_or_file_path> [--file] [--ndjson] [--parallel] [--stats[=json]] [--query=<jsonpath>]\n";
             return 1;
         }
 
         std::string input = argv[1];
-        const bool isFile = (argc == 3 && std::string(argv[2]) == "--file");
+        bool isFile = false;
+        bool isNdjson = false;
+        bool isParallel = false;
+        bool showStats = false;
+        bool statsAsJson = false;
+        std::optional<JsonPath> query;
+        for (int i = 2; i < argc; ++i) {
+            if (const std::string flag = argv[i]; flag == "--file") {
+                isFile = true;
+            } else if (flag == "--ndjson") {
+                isNdjson = true;
+            } else if (flag == "--parallel") {
+                isParallel = true;
+            } else if (flag == "--stats" || flag == "--stats=json") {
+                showStats = true;
+                statsAsJson = flag == "--stats=json";
+            } else if (flag.starts_with("--query=")) {
+                query = JsonPath::compile(flag.substr(8));
+            } else {
+                std::cerr << "Unknown option: " << flag << "\n";
+                return 1;
+            }
+        }
+
+        if (showStats && (isNdjson || isParallel)) {
+            std::cerr << "--stats cannot be combined with --ndjson or --parallel\n";
+            return 1;
+        }
+
+        if (query && (showStats || isNdjson || isParallel)) {
+            std::cerr << "--query cannot be combined with --stats, --ndjson or --parallel\n";
+            return 1;
+        }
 
-        Parser parser(input, isFile);
-        const auto root = parser.parse();
+        if (query) {
+            std::optional<MappedFile> file;
+            if (isFile) {
+                file.emplace(input);
+            }
+            JsonWriter writer = JsonWriter::toFile(stdout);
+            for (const auto& match: query->select(file ? file->view() : std::string_view(input))) {
+                writer.write(*match);
+            }
+            writer.flush();
+            std::cout << "\n";
+            return 0;
+        }
+
+        if (isNdjson) {
+            size_t records = 0;
+            size_t failures = 0;
+            JsonWriter writer = JsonWriter::toFile(stdout);
+            const auto printRecord = [&](NdjsonRecord&& record) {
+                ++records;
+                if (record.value) {
+                    writer.write(*record.value);
+                } else {
+                    ++failures;
+                    std::cerr << "Error at offset " << record.offset << ": " << record.error << "\n";
+                }
+            };
 
-        std::cout << "Parsed JSON structure:\n";
-        printJson(root);
+            if (isFile) {
+                parseNdjsonFile(input, printRecord);
+            } else {
+                parseNdjson(input, printRecord);
+            }
+            writer.flush();
+
+            std::cout << "\nParsed " << records - failures << " of " << records << " NDJSON records\n";
+            return failures == 0 ? 0 : 1;
+        }
+
+        ParseStats stats;
+        std::shared_ptr<JsonValue> root;
+        if (showStats) {
+            root = parseWithStats(input, isFile, stats);
+        } else if (isParallel) {
+            root = isFile ? parseArrayParallelFile(input) : parseArrayParallel(input);
+        } else {
+            Parser parser(input, isFile);
+            root = parser.parse();
+        }
+
+        std::cout << "Parsed JSON structure:" << std::endl;
+        JsonWriter writer = JsonWriter::toFile(stdout, {.pretty = true});
+        writer.write(*root);
+        writer.flush();
+        std::cout << "\n";
+
+        if (showStats) {
+            releaseWithStats(root, stats);
+            std::cerr << (statsAsJson ? stats.toJson() + "\n" : stats.toText());
+        }
 
     } catch (const std::exception& ex) {
         std::cerr << "Error: " << ex.what() << std::endl;
@@ -59,4 +117,4 @@ int main(const int argc, char* argv[]) {
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <core/Bind.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+    enum class Role { Admin, Editor, Viewer };
+    JSON_ENUM(Role, Admin, Editor, Viewer)
+
+    enum class Level : uint8_t { Low = 1, High = 2 };
+
+    struct Point {
+        double x{};
+        double y{};
+    };
+    JSON_FIELDS(Point, x, y)
+
+    struct User {
+        int64_t id{};
+        std::string name;
+        bool active{};
+        Role role{};
+        Level level{};
+        std::optional<std::string> email;
+        std::vector<Point> path;
+        std::vector<std::vector<int>> matrix;
+        std::optional<Point> home;
+        uint16_t port{};
+    };
+    JSON_FIELDS(User, id, name, active, role, level, email, path, matrix, home, port)
+}
+
+TEST(BindTests, ParsesNestedStruct) {
+    const auto user = parse<User>(R"({
+        "name": "Alice", "id": 9007199254740993, "active": true, "role": "Editor", "level": 2,
+        "unknown": {"deep": [1, {"a": null}]},
+        "path": [{"x": 1, "y": 2.5}, {"y": -1e2, "x": 0}],
+        "matrix": [[1, 2], [], [3]],
+        "home": null, "port": 8080
+    })");
+
+    EXPECT_EQ(user.id, 9007199254740993);
+    EXPECT_EQ(user.name, "Alice");
+    EXPECT_TRUE(user.active);
+    EXPECT_EQ(user.role, Role::Editor);
+    EXPECT_EQ(user.level, Level::High);
+    EXPECT_FALSE(user.email.has_value());
+    ASSERT_EQ(user.path.size(), 2);
+    EXPECT_EQ(user.path[0].y, 2.5);
+    EXPECT_EQ(user.path[1].y, -100.0);
+    EXPECT_EQ(user.matrix, (std::vector<std::vector<int>>{{1, 2}, {}, {3}}));
+    EXPECT_FALSE(user.home.has_value());
+    EXPECT_EQ(user.port, 8080);
+
+    EXPECT_EQ(parse<std::vector<Point>>("[{\"x\": 3, \"y\": 4}]")[0].x, 3.0);
+    EXPECT_EQ(parse<std::optional<Point>>(R"({"x": 1, "y": 1})")->y, 1.0);
+}
+
+TEST(BindTests, RejectsMismatches) {
+    EXPECT_THROW(parse<Point>(R"({"x": 1})"), std::runtime_error);
+    EXPECT_THROW(parse<Point>(R"({"x": "1", "y": 2})"), std::runtime_error);
+    EXPECT_THROW(parse<Point>(R"({"x": 1, "y": 2} [])"), std::runtime_error);
+    EXPECT_THROW(parse<Role>(R"("Owner")"), std::runtime_error);
+    EXPECT_THROW(parse<uint16_t>("70000"), std::runtime_error);
+    EXPECT_THROW(parse<int>("1.5"), std::runtime_error);
+    EXPECT_THROW(parse<std::vector<int>>("[1, 2"), std::runtime_error);
+    EXPECT_THROW(parse<Point>(R"({"x": 1, "y": 2, "z": [})"), std::runtime_error);
+}
+
+TEST(BindTests, LocatesErrors) {
+    const auto errorOf = [](const auto parseIt) {
+        try {
+            parseIt();
+        } catch (const ParseException& exception) {
+            return exception.error();
+        }
+        ADD_FAILURE() << "expected a ParseException";
+        return ParseError{};
+    };
+
+    const ParseError mismatch = errorOf([] { parse<Point>("{\"x\": 1,\n \"y\": \"2\"}"); });
+    EXPECT_EQ(mismatch.code, ParseErrorCode::UnexpectedToken);
+    EXPECT_EQ(mismatch.line, 2u);
+    EXPECT_EQ(mismatch.column, 7u);
+    EXPECT_EQ(errorOf([] { parse<Point>(R"({"x": 1 "y": 2})"); }).code, ParseErrorCode::ExpectedCommaOrEnd);
+    EXPECT_EQ(errorOf([] { parse<Point>(R"({"x" 1})"); }).code, ParseErrorCode::ExpectedColon);
+    EXPECT_EQ(errorOf([] { parse<Point>(R"({"x": 1, "y": 2} [])"); }).column, 18u);
+    EXPECT_EQ(errorOf([] { parse<uint16_t>("70000"); }).code, ParseErrorCode::NumberOutOfRange);
+    EXPECT_EQ(errorOf([] { parse<std::vector<int>>("[1, 2"); }).code, ParseErrorCode::UnexpectedEnd);
+}
+
+TEST(BindTests, RejectsTrailingCommas) {
+    EXPECT_THROW(parse<Point>(R"({"x": 1, "y": 2,})"), std::runtime_error);
+    EXPECT_THROW(parse<Point>(R"({,})"), std::runtime_error);
+    EXPECT_THROW(parse<std::vector<int>>("[1, 2,]"), std::runtime_error);
+    EXPECT_THROW(parse<std::vector<Point>>("[,]"), std::runtime_error);
+    EXPECT_THROW(parse<User>(R"({"id": 1, "matrix": [[1, 2,]], "name": "a", "active": true, "role": "Admin",)"
+                             R"( "level": 1, "path": [], "port": 1})"), std::runtime_error);
+    EXPECT_NO_THROW(parse<User>(R"({"id": 1, "matrix": [[1, 2]], "name": "a", "active": true, "role": "Admin",)"
+                                R"( "level": 1, "path": [], "port": 1})"));
+    EXPECT_TRUE(parse<std::vector<int>>("[]").empty());
+}
+
+TEST(BindTests, KeyTableIsPerfect) {
+    using Binding = JsonBinding<User>;
+    for (size_t i = 0; i < Binding::count; ++i) {
+        EXPECT_EQ(Binding::keys.find(Binding::names[i]), static_cast<int>(i));
+    }
+    static_assert(Binding::keys.find("matrix") == 7);
+    static_assert(Binding::keys.find("missing") == -1);
+    static_assert(!Binding::required[5] && Binding::required[0]);
+}
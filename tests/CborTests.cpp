@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <core/Cbor.hpp>
+#include <core/Writer.hpp>
+
+#include <cmath>
+#include <filesystem>
+#include <string>
+
+namespace {
+    std::string fromHex(const std::string_view hex) {
+        std::string bytes;
+        for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+            bytes += static_cast<char>(std::stoi(std::string(hex.substr(i, 2)), nullptr, 16));
+        }
+        return bytes;
+    }
+
+    std::string toHex(const std::string_view bytes) {
+        static constexpr char digits[] = "0123456789abcdef";
+        std::string hex;
+        for (const char c: bytes) {
+            hex += digits[static_cast<unsigned char>(c) >> 4];
+            hex += digits[static_cast<unsigned char>(c) & 0xf];
+        }
+        return hex;
+    }
+
+    std::string encodeJson(const std::string& json) {
+        return toHex(encodeCbor(*Parser(json).parse()));
+    }
+
+    std::string decodeHex(const std::string_view hex) {
+        return toJson(*decodeCbor(fromHex(hex)));
+    }
+}
+
+TEST(CborTests, EncodesShortestHeads) {
+    // Examples from RFC 8949, Appendix A.
+    EXPECT_EQ(encodeJson("0"), "00");
+    EXPECT_EQ(encodeJson("23"), "17");
+    EXPECT_EQ(encodeJson("24"), "1818");
+    EXPECT_EQ(encodeJson("1000"), "1903e8");
+    EXPECT_EQ(encodeJson("1000000"), "1a000f4240");
+    EXPECT_EQ(encodeJson("1000000000000"), "1b000000e8d4a51000");
+    EXPECT_EQ(encodeJson("18446744073709551615"), "1bffffffffffffffff");
+    EXPECT_EQ(encodeJson("-1"), "20");
+    EXPECT_EQ(encodeJson("-1000"), "3903e7");
+    EXPECT_EQ(encodeJson("-9223372036854775808"), "3b7fffffffffffffff");
+    EXPECT_EQ(encodeJson("1.5"), "fa3fc00000");
+    EXPECT_EQ(encodeJson("1.1"), "fb3ff199999999999a");
+    EXPECT_EQ(encodeJson(R"("a")"), "6161");
+    EXPECT_EQ(encodeJson(R"("ü")"), "62c3bc");
+    EXPECT_EQ(encodeJson("[1, [2, 3], []]"), "8301820203" "80");
+#ifdef JSON_FLAT_OBJECT
+    EXPECT_EQ(encodeJson(R"({"a": 1, "b": [2, 3]})"), "a26161016162820203");
+#endif
+    EXPECT_EQ(encodeJson(R"({"a": 1})"), "a1616101");
+    EXPECT_EQ(encodeJson("[false, true, null]"), "83f4f5f6");
+}
+
+TEST(CborTests, DecodesEveryEncoding) {
+    EXPECT_EQ(decodeHex("1b000000e8d4a51000"), "1000000000000");
+    EXPECT_EQ(decodeHex("3863"), "-100");
+    EXPECT_EQ(decodeHex("f93c00"), "1.0");
+    EXPECT_EQ(decodeHex("f97bff"), "65504.0");
+    EXPECT_DOUBLE_EQ(std::get<double>(decodeCbor(fromHex("f90001"))->value()), 5.960464477539063e-8);
+    EXPECT_DOUBLE_EQ(std::get<double>(decodeCbor(fromHex("fa47c35000"))->value()), 100000.0);
+    EXPECT_EQ(decodeHex("9f018202039f0405ffff"), "[1,[2,3],[4,5]]");
+    const auto map = decodeCbor(fromHex("bf61610161629f0203ffff"));
+    EXPECT_EQ(toJson(*std::get<JsonObject>(map->value()).at("a")), "1");
+    EXPECT_EQ(toJson(*std::get<JsonObject>(map->value()).at("b")), "[2,3]");
+    EXPECT_EQ(decodeHex("7f657374726561646d696e67ff"), R"("streaming")");
+    EXPECT_EQ(decodeHex("c074323031332d30332d32315432303a30343a30305a"), R"("2013-03-21T20:04:00Z")");
+    EXPECT_EQ(toJson(*decodeCbor(std::string(2000000, '\xc0') + '\x01')), "1");
+    EXPECT_DOUBLE_EQ(std::get<double>(decodeCbor(fromHex("3bffffffffffffffff"))->value()), -18446744073709551616.0);
+    EXPECT_TRUE(std::isinf(std::get<double>(decodeCbor(fromHex("f9fc00"))->value())));
+}
+
+TEST(CborTests, RoundTripsDocuments) {
+    const std::string json = R"({"id": 9007199254740993, "big": 18446744073709551615, "neg": -42,)"
+                             R"( "pi": 3.141592653589793, "half": 0.5, "text": "line\nbreak \"quoted\" €",)"
+                             R"( "list": [true, false, null, [], {}], "nested": {"deep": [[[1]]]}})";
+    const auto original = Parser(json).parse();
+    const std::string bytes = encodeCbor(*original);
+    EXPECT_LT(bytes.size(), json.size());
+
+    const auto decoded = decodeCbor(bytes);
+    const auto& object = std::get<JsonObject>(decoded->value());
+    EXPECT_EQ(std::get<int64_t>(object.at("id")->value()), 9007199254740993);
+    EXPECT_EQ(std::get<uint64_t>(object.at("big")->value()), 18446744073709551615u);
+    EXPECT_EQ(std::get<std::string>(object.at("text")->value()), "line\nbreak \"quoted\" €");
+    EXPECT_EQ(toJson(*object.at("nested")), R"({"deep":[[[1]]]})");
+#ifdef JSON_FLAT_OBJECT
+    // Members only come back in the same order when objects keep it.
+    EXPECT_EQ(toJson(*decoded), toJson(*original));
+    EXPECT_EQ(encodeCbor(*decoded), bytes);
+#endif
+}
+
+TEST(CborTests, RoundTripsFiles) {
+    const std::string path = "roundtrip.cbor";
+    const auto original = Parser(R"({"cached": [1, 2.5, "three"]})").parse();
+    writeCborFile(path, *original);
+    EXPECT_EQ(toJson(*readCborFile(path)), toJson(*original));
+    std::filesystem::remove(path);
+    EXPECT_THROW(readCborFile(path), std::runtime_error);
+}
+
+TEST(CborTests, RejectsMalformedData) {
+    for (const char* hex: {"", "19", "62c3", "830102", "40", "a10102", "0000", "62c328", "1c", "f7", "9f01",
+                           "7f01ff", "a1"}) {
+        EXPECT_THROW(decodeCbor(fromHex(hex)), std::runtime_error) << hex;
+    }
+    EXPECT_THROW(decodeCbor(std::string(2000, '\x81') + '\x00'), std::runtime_error);
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <core/Document.hpp>
+
+#include <limits>
+
+TEST(DocumentTests, NavigateWithHandles) {
+    const auto document = Document::parse(R"(
+        {
+            "user": {
+                "id": 123,
+                "name": "John Doe",
+                "isActive": true,
+                "roles": ["admin", "editor"],
+                "manager": null
+            }
+        }
+    )");
+
+    const ValueRef user = document.root()["user"];
+    ASSERT_TRUE(user.isObject());
+    EXPECT_EQ(user.size(), 5);
+    EXPECT_EQ(user["id"].asInt64(), 123);
+    EXPECT_EQ(user["name"].asString(), "John Doe");
+    EXPECT_TRUE(user["isActive"].asBoolean());
+    EXPECT_TRUE(user["manager"].isNull());
+    EXPECT_EQ(user["roles"][1].asString(), "editor");
+    EXPECT_FALSE(user.find("missing"));
+    EXPECT_THROW(user["missing"], std::runtime_error);
+    EXPECT_THROW((void) user["name"].asNumber(), std::runtime_error);
+}
+
+TEST(DocumentTests, MembersKeepDocumentOrder) {
+    const auto document = Document::parse(R"({"b": 1, "a": 2, "c": 3})");
+
+    std::string keys;
+    for (const DomMember &member: document.root().members()) {
+        keys += member.key();
+    }
+    EXPECT_EQ(keys, "bac");
+}
+
+TEST(DocumentTests, OutlivesInputBuffer) {
+    auto json = std::make_unique<std::string>(R"(["first", {"key": "second"}])");
+    const auto document = Document::parse(*json);
+    json.reset();
+
+    EXPECT_EQ(document.root()[0].asString(), "first");
+    EXPECT_EQ(document.root()[1]["key"].asString(), "second");
+}
+
+TEST(DocumentTests, ConvertsToAndFromJsonValue) {
+    const auto document = Document::parse(R"({"list": [1, "two", false, null], "nested": {"x": 2.5}})");
+
+    const auto value = document.toJsonValue();
+    const auto &obj = std::get<JsonObject>(value->value());
+    const auto &list = std::get<JsonArray>(obj.at("list")->value());
+    ASSERT_EQ(list.size(), 4);
+    EXPECT_EQ(std::get<int64_t>(list[0]->value()), 1);
+    EXPECT_EQ(std::get<std::string>(list[1]->value()), "two");
+    EXPECT_EQ(std::get<double>(std::get<JsonObject>(obj.at("nested")->value()).at("x")->value()), 2.5);
+
+    const auto roundTrip = Document::fromJsonValue(*value);
+    EXPECT_EQ(roundTrip.root()["list"][0].asInt64(), 1);
+    EXPECT_EQ(roundTrip.root()["nested"]["x"].asNumber(), 2.5);
+    EXPECT_TRUE(roundTrip.root()["list"][3].isNull());
+}
+
+TEST(DocumentTests, InvalidInput) {
+    EXPECT_THROW(Document::parse(R"({"key": })"), std::runtime_error);
+    EXPECT_THROW(Document::parse("[1, 2"), std::runtime_error);
+}
+
+TEST(DocumentTests, PreservesLargeIntegers) {
+    const auto document = Document::parse(R"([9007199254740993, 18446744073709551615, -9223372036854775808, 1.5])");
+    const ValueRef root = document.root();
+
+    EXPECT_EQ(root[0].asInt64(), 9007199254740993);
+    EXPECT_EQ(root[1].numberType(), NumberType::UInt64);
+    EXPECT_EQ(root[1].asUInt64(), 18446744073709551615ULL);
+    EXPECT_EQ(root[2].asInt64(), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(root[3].numberType(), NumberType::Double);
+    EXPECT_THROW((void) root[3].asInt64(), std::runtime_error);
+}
+
+TEST(DocumentTests, KeyInternerPoolsDistinctKeys) {
+    KeyInterner keys;
+    const InternedKey* id = keys.intern("id");
+    EXPECT_EQ(keys.intern(std::string("i") + "d"), id);
+    EXPECT_EQ(keys.find("id"), id);
+    EXPECT_EQ(keys.find("name"), nullptr);
+
+    for (int i = 0; i < 1000; ++i) {
+        keys.intern("key" + std::to_string(i));
+    }
+    EXPECT_EQ(keys.size(), 1001);
+    EXPECT_EQ(keys.intern("id"), id);
+    EXPECT_EQ(keys[500].view(), "key499");
+    EXPECT_EQ(keys.find("key999")->id, 1000);
+}
+
+TEST(DocumentTests, RepeatedKeysAreStoredOnce) {
+    const auto document = Document::parse(R"([{"id": 1, "name": "a"}, {"id": 2, "name": "b"}, {"name": "c", "id": 3}])");
+    const ValueRef root = document.root();
+
+    EXPECT_EQ(document.keyCount(), 2);
+    EXPECT_EQ(root[0].members()[0].name, root[2].members()[1].name);
+
+    const InternedKey* name = document.key("name");
+    ASSERT_NE(name, nullptr);
+    EXPECT_EQ(root[2].find(name).asString(), "c");
+    EXPECT_EQ(document.key("missing"), nullptr);
+    EXPECT_FALSE(root[0].find(document.key("missing")));
+}
+
+TEST(DocumentTests, SharedKeysAreReused) {
+    KeyInterner schema;
+    const InternedKey* id = schema.intern("id");
+
+    const auto document = Document::parse(R"({"id": 7, "extra": {"id": 8}})", schema);
+    EXPECT_EQ(document.keyCount(), 1);
+    EXPECT_EQ(document.key("id"), id);
+    EXPECT_EQ(document.root().find(id).asInt64(), 7);
+    EXPECT_EQ(document.root()["extra"].find(id).asInt64(), 8);
+}
+
+TEST(DocumentTests, TryParseReturnsDocument) {
+    const auto document = Document::tryParse(R"({"a": [1, 2]})");
+    ASSERT_TRUE(document.has_value());
+    EXPECT_EQ(document->root()["a"][1].asInt64(), 2);
+}
+
+TEST(DocumentTests, TryParseReportsErrorPositions) {
+    const auto expectError = [](const std::string_view json, const ParseErrorCode code, const uint32_t line, const uint32_t column) {
+        const auto document = Document::tryParse(json);
+        ASSERT_FALSE(document.has_value()) << json;
+        EXPECT_EQ(document.error().code, code) << json;
+        EXPECT_EQ(document.error().line, line) << json;
+        EXPECT_EQ(document.error().column, column) << json;
+    };
+
+    expectError("{\n  \"a\": 1,\n  \"b\" 2\n}", ParseErrorCode::ExpectedColon, 3, 7);
+    expectError("[1, 2", ParseErrorCode::UnexpectedEnd, 1, 6);
+    expectError("[1 2]", ParseErrorCode::ExpectedCommaOrEnd, 1, 4);
+    expectError("[1,]", ParseErrorCode::UnexpectedToken, 1, 4);
+    expectError("{,}", ParseErrorCode::ExpectedKey, 1, 2);
+    expectError("[1] [2]", ParseErrorCode::TrailingContent, 1, 5);
+    expectError("[\n\"abc", ParseErrorCode::UnterminatedString, 2, 1);
+    expectError("[tru]", ParseErrorCode::InvalidKeyword, 1, 2);
+    expectError("[01]", ParseErrorCode::InvalidNumber, 1, 2);
+    expectError("[1, 1e999]", ParseErrorCode::NumberOutOfRange, 1, 5);
+    expectError("", ParseErrorCode::UnexpectedEnd, 1, 1);
+
+    const auto document = Document::tryParse("[1,\n?]");
+    ASSERT_FALSE(document.has_value());
+    EXPECT_EQ(document.error().offset, 4);
+    EXPECT_EQ(document.error().message(), "Unexpected token at line 2, column 1");
+}
+
+TEST(DocumentTests, ParseThrowsParseException) {
+    try {
+        (void) Document::parse("[1, 2] x");
+        FAIL() << "Expected ParseException";
+    } catch (const ParseException& ex) {
+        EXPECT_EQ(ex.error().code, ParseErrorCode::TrailingContent);
+        EXPECT_EQ(ex.error().column, 8);
+    }
+}
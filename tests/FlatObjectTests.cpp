@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <core/FlatObject.hpp>
+#include <core/Parser.hpp>
+#include <core/Writer.hpp>
+
+#include <string>
+#include <vector>
+
+TEST(FlatObjectTests, KeepsInsertionOrder) {
+    FlatObject<int> object;
+    EXPECT_TRUE(object.emplace("b", 1).second);
+    EXPECT_TRUE(object.emplace("a", 2).second);
+    EXPECT_TRUE(object.emplace("c", 3).second);
+
+    const auto [existing, inserted] = object.emplace("a", 99);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(existing->second, 2);
+
+    std::vector<std::string> keys;
+    for (const auto& [key, value]: object) {
+        keys.push_back(key);
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"b", "a", "c"}));
+
+    EXPECT_EQ(object.at("c"), 3);
+    EXPECT_THROW((void) object.at("d"), std::out_of_range);
+    EXPECT_EQ(object.find("d"), object.end());
+
+    object["d"] = 4;
+    object.insert_or_assign("b", 10);
+    EXPECT_EQ(object.erase("a"), 1);
+    EXPECT_EQ(object.erase("a"), 0);
+    EXPECT_EQ(object.size(), 3);
+    EXPECT_EQ(object.begin()->second, 10);
+    EXPECT_EQ((object.end() - 1)->first, "d");
+}
+
+TEST(FlatObjectTests, IndexesLargeObjects) {
+    FlatObject<int> object;
+    for (int i = 0; i < 1000; ++i) {
+        object.emplace("key" + std::to_string(i), i);
+    }
+    EXPECT_FALSE(object.emplace("key500", -1).second);
+    for (int i = 0; i < 1000; i += 37) {
+        EXPECT_EQ(object.at("key" + std::to_string(i)), i);
+    }
+    EXPECT_FALSE(object.contains("key1000"));
+
+    for (int i = 0; i < 995; ++i) {
+        object.erase("key" + std::to_string(i));
+    }
+    EXPECT_EQ(object.size(), 5);
+    EXPECT_EQ(object.at("key997"), 997);
+    EXPECT_EQ(object.begin()->first, "key995");
+
+    FlatObject<int> copy = object;
+    EXPECT_TRUE(copy == object);
+    copy["key995"] = 0;
+    EXPECT_FALSE(copy == object);
+}
+
+#ifdef JSON_FLAT_OBJECT
+TEST(FlatObjectTests, ParserRoundTripsKeyOrder) {
+    const std::string json = R"({"zeta":1,"alpha":{"y":true,"x":null},"mid":[1,2]})";
+    Parser parser(json);
+    EXPECT_EQ(toJson(*parser.parse()), json);
+}
+#endif
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <core/JsonPath.hpp>
+#include <core/Writer.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+    const std::string Store = R"({
+        "store": {
+            "book": [
+                {"category": "reference", "author": "Nigel Rees", "title": "Sayings", "price": 8.95},
+                {"category": "fiction", "author": "Evelyn Waugh", "title": "Sword", "price": 12.99},
+                {"category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553", "price": 8.99},
+                {"category": "fiction", "author": "J. R. R. Tolkien", "title": "The Lord", "isbn": "0-395", "price": 22.99}
+            ],
+            "bicycle": {"color": "red", "price": 19.95}
+        },
+        "expensive": 10
+    })";
+
+    std::vector<std::string> serialize(const std::vector<std::shared_ptr<JsonValue> >& values) {
+        std::vector<std::string> texts;
+        for (const auto& value: values) {
+            JsonWriter writer;
+            writer.write(*value);
+            texts.push_back(writer.take());
+        }
+        return texts;
+    }
+
+    /**
+     * Selects from text and from the parsed tree, which must agree.
+     */
+    std::vector<std::string> select(const std::string_view path, const std::string& json = Store) {
+        const JsonPath compiled = JsonPath::compile(path);
+        std::vector<std::string> streamed = serialize(compiled.select(json));
+        std::vector<std::string> walked = serialize(compiled.select(Parser(json).parse()));
+#ifdef JSON_FLAT_OBJECT
+        EXPECT_EQ(streamed, walked) << path;
+#else
+        // Unordered objects are walked in no particular order.
+        std::vector<std::string> sorted = streamed;
+        std::ranges::sort(sorted);
+        std::ranges::sort(walked);
+        EXPECT_EQ(sorted, walked) << path;
+#endif
+        return streamed;
+    }
+
+    using Texts = std::vector<std::string>;
+}
+
+TEST(JsonPathTests, SelectsChildrenAndWildcards) {
+    EXPECT_EQ(select("$.expensive"), Texts{"10"});
+#ifdef JSON_FLAT_OBJECT
+    EXPECT_EQ(select("$.store.bicycle"), Texts{R"({"color":"red","price":19.95})"});
+#endif
+    EXPECT_EQ(select("$['store']['bicycle'].color"), Texts{R"("red")"});
+    EXPECT_EQ(select("$.store.book[*].author"),
+              (Texts{R"("Nigel Rees")", R"("Evelyn Waugh")", R"("Herman Melville")", R"("J. R. R. Tolkien")"}));
+    EXPECT_EQ(select("$.store.*.price"), Texts{"19.95"});
+    EXPECT_EQ(select("$.missing.path"), Texts{});
+    EXPECT_EQ(select("$").size(), 1);
+}
+
+TEST(JsonPathTests, SelectsIndicesSlicesAndUnions) {
+    EXPECT_EQ(select("$.store.book[2].title"), Texts{R"("Moby Dick")"});
+    EXPECT_EQ(select("$.store.book[1:3].title"), (Texts{R"("Sword")", R"("Moby Dick")"}));
+    EXPECT_EQ(select("$.store.book[::2].title"), (Texts{R"("Sayings")", R"("Moby Dick")"}));
+    EXPECT_EQ(select("$.store.book[:1].title"), Texts{R"("Sayings")"});
+    EXPECT_EQ(select("$.store.book[3, 0].title"), (Texts{R"("Sayings")", R"("The Lord")"}));
+    EXPECT_EQ(select("$.store.bicycle['price', 'color']"), (Texts{R"("red")", "19.95"}));
+    EXPECT_EQ(select("$.store.book[9]"), Texts{});
+}
+
+TEST(JsonPathTests, SelectsDescendants) {
+    EXPECT_EQ(select("$..price"), (Texts{"8.95", "12.99", "8.99", "22.99", "19.95"}));
+    EXPECT_EQ(select("$.store..isbn"), (Texts{R"("0-553")", R"("0-395")"}));
+    EXPECT_EQ(select("$..book[1].price"), Texts{"12.99"});
+    EXPECT_EQ(select("$..*").size(), 28);
+
+    // Matches nested in other matches come after them, in document order.
+    EXPECT_EQ(select("$..a", R"({"a": {"b": {"a": 1}}, "c": [{"a": 2}]})"),
+              (Texts{R"({"b":{"a":1}})", "1", "2"}));
+}
+
+TEST(JsonPathTests, FiltersCandidates) {
+    EXPECT_EQ(select("$.store.book[?(@.price < 10)].title"), (Texts{R"("Sayings")", R"("Moby Dick")"}));
+    EXPECT_EQ(select("$.store.book[?@.isbn].title"), (Texts{R"("Moby Dick")", R"("The Lord")"}));
+    EXPECT_EQ(select("$.store.book[?(!@.isbn)].title"), (Texts{R"("Sayings")", R"("Sword")"}));
+    EXPECT_EQ(select("$..book[?(@.category == 'fiction' && @.price > 20)].author"), Texts{R"("J. R. R. Tolkien")"});
+    EXPECT_EQ(select("$..book[?(@.author == \"Nigel Rees\" || @.price >= 22.99)].price"), (Texts{"8.95", "22.99"}));
+    EXPECT_EQ(select("$..[?(@.color)].price"), Texts{"19.95"});
+    EXPECT_EQ(select("$.a[?(@ > 1)]", R"({"a": [1, 2, "3", 4]})"), (Texts{"2", "4"}));
+    EXPECT_EQ(select("$.a[?(@[-1] == 3)]", R"({"a": [[1, 3], [3, 1], []]})"), Texts{"[1,3]"});
+    EXPECT_EQ(select("$.a[?(@.x != null)].x", R"({"a": [{"x": null}, {"x": 0}, {}]})"), Texts{"0"});
+}
+
+TEST(JsonPathTests, DecodesEscapedKeys) {
+    EXPECT_EQ(select(R"($['a\'b', "c\u0064"])", R"({"a'b": 1, "x": 0, "c\u0064": 2})"), (Texts{"1", "2"}));
+}
+
+TEST(JsonPathTests, RejectsUnsupportedExpressions) {
+    for (const char* path: {"", "store", "$.", "$[", "$[-1]", "$[0:-1]", "$[::0]", "$.a[?(@.b <)]", "$[?(1)]",
+                            "$['a'", "$x"}) {
+        EXPECT_THROW((void) JsonPath::compile(path), std::runtime_error) << path;
+    }
+}
+
+TEST(JsonPathTests, ReportsMalformedInput) {
+    const JsonPath path = JsonPath::compile("$.a");
+    EXPECT_THROW((void) path.select(R"({"a": 1, "b": [1, 2})"), ParseException);
+    EXPECT_THROW((void) path.select(R"({"a": 1} 2)"), ParseException);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <core/LazyDocument.hpp>
+
+namespace {
+    const std::string json = R"(
+        {
+            "skipped": {"deep": [[1, 2], {"x": "}]"}], "more": "text"},
+            "user": {
+                "id": 9007199254740993,
+                "name": "John Doe",
+                "isActive": true,
+                "roles": ["admin", "editor", "viewer"],
+                "a/b": 1,
+                "m~n": 2,
+                "manager": null
+            },
+            "": "empty key"
+        }
+    )";
+}
+
+TEST(LazyDocumentTests, JsonPointerLookups) {
+    const LazyDocument document(json);
+
+    EXPECT_EQ(std::get<int64_t>(document.at("/user/id").asNumber()), 9007199254740993);
+    EXPECT_EQ(document.at("/user/name").asString(), "John Doe");
+    EXPECT_TRUE(document.at("/user/isActive").asBoolean());
+    EXPECT_EQ(document.at("/user/roles/2").asString(), "viewer");
+    EXPECT_EQ(document.at("/user/manager").type(), LazyValue::Type::Null);
+    EXPECT_EQ(std::get<int64_t>(document.at("/user/a~1b").asNumber()), 1);
+    EXPECT_EQ(std::get<int64_t>(document.at("/user/m~0n").asNumber()), 2);
+    EXPECT_EQ(document.at("/").asString(), "empty key");
+    EXPECT_EQ(document.at("").type(), LazyValue::Type::Object);
+}
+
+TEST(LazyDocumentTests, MissingPaths) {
+    const LazyDocument document(json);
+
+    EXPECT_FALSE(document.find("/user/missing"));
+    EXPECT_FALSE(document.find("/user/roles/3"));
+    EXPECT_FALSE(document.find("/user/roles/01"));
+    EXPECT_FALSE(document.find("/user/roles/-"));
+    EXPECT_FALSE(document.find("/user/roles/18446744073709551617"));
+    EXPECT_FALSE(document.find("/user/roles/99999999999999999999999"));
+    EXPECT_FALSE(document.find("/user/name/first"));
+    EXPECT_THROW((void) document.at("/nope"), std::runtime_error);
+    EXPECT_THROW((void) document.find("user"), std::runtime_error);
+    EXPECT_THROW((void) document.find("/bad~2escape"), std::runtime_error);
+}
+
+TEST(LazyDocumentTests, ChainedLookupsAndMaterialize) {
+    const LazyDocument document(json);
+    const LazyValue user = document.root()["user"];
+
+    EXPECT_EQ(user.size(), 7);
+    EXPECT_EQ(user["roles"].size(), 3);
+    EXPECT_EQ(document.root()["skipped"]["deep"][1]["x"].asString(), "}]");
+    EXPECT_EQ(user["roles"].text(), R"(["admin", "editor", "viewer"])");
+    EXPECT_EQ(user["id"].text(), "9007199254740993");
+
+    const auto roles = user["roles"].materialize();
+    const auto &array = std::get<JsonArray>(roles->value());
+    ASSERT_EQ(array.size(), 3);
+    EXPECT_EQ(std::get<std::string>(array[0]->value()), "admin");
+}
+
+TEST(LazyDocumentTests, RejectsUnbalancedInput) {
+    EXPECT_THROW(LazyDocument(R"({"a": [1, 2})"), std::runtime_error);
+    EXPECT_THROW(LazyDocument(R"({"a": "open)"), std::runtime_error);
+    EXPECT_THROW(LazyDocument("[[]"), std::runtime_error);
+    EXPECT_THROW(LazyDocument("   "), std::runtime_error);
+}
+
+TEST(LazyDocumentTests, MatchesAndDecodesEscapedStrings) {
+    const LazyDocument document(R"({"say \"hi\"": "caf\u00e9\n", "tab\tbed": 1})");
+
+    EXPECT_EQ(document.root()["say \"hi\""].asString(), "caf\xC3\xA9\n");
+    EXPECT_EQ(document.at("/say \"hi\"").asString(), "caf\xC3\xA9\n");
+    EXPECT_FALSE(document.root().find("say \\\"hi\\\""));
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <core/FileReader.hpp>
+#include <core/MappedFile.hpp>
+#include <core/Document.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+    void createTestFile(const std::string& filePath, const std::string& content) {
+        std::ofstream file(filePath, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to create test file: " + filePath);
+        }
+        file << content;
+    }
+}
+
+TEST(MappedFileTests, MapsWholeFile) {
+    const std::string filePath = "mapped_file.json";
+    const std::string content = R"({"mapped": [1, 2, 3]})";
+    createTestFile(filePath, content);
+
+    {
+        const MappedFile file(filePath);
+        EXPECT_TRUE(file.isMapped());
+        EXPECT_EQ(file.view(), content);
+        EXPECT_EQ(FileReader::read(filePath), content);
+
+        const MappedFile moved = MappedFile(filePath);
+        EXPECT_EQ(moved.size(), content.size());
+    }
+
+    std::filesystem::remove(filePath);
+}
+
+TEST(MappedFileTests, EmptyFile) {
+    const std::string filePath = "empty_file.json";
+    createTestFile(filePath, "");
+
+    {
+        const MappedFile file(filePath);
+        EXPECT_EQ(file.size(), 0);
+        EXPECT_TRUE(file.view().empty());
+    }
+
+    std::filesystem::remove(filePath);
+}
+
+TEST(MappedFileTests, Errors) {
+    EXPECT_THROW(MappedFile("nonexistent_file.json"), std::runtime_error);
+    EXPECT_THROW(MappedFile("."), std::runtime_error);
+    EXPECT_THROW(FileReader::read("nonexistent_file.json"), std::runtime_error);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(MappedFileTests, ReadsPipesToEnd) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    // More than a pipe holds, so the writer runs alongside the read and the
+    // buffer has to grow.
+    const std::string content = "[" + std::string(200000, ' ') + "1]";
+    std::thread writer([&] {
+        for (size_t done = 0; done < content.size();) {
+            const ssize_t n = ::write(fds[1], content.data() + done, content.size() - done);
+            if (n <= 0) {
+                break;
+            }
+            done += static_cast<size_t>(n);
+        }
+        ::close(fds[1]);
+    });
+
+    const MappedFile file("/dev/fd/" + std::to_string(fds[0]));
+    writer.join();
+    ::close(fds[0]);
+    EXPECT_FALSE(file.isMapped());
+    EXPECT_EQ(file.view(), content);
+}
+#endif
+
+TEST(MappedFileTests, DocumentFromFile) {
+    const std::string filePath = "document_file.json";
+    createTestFile(filePath, R"({"city": "New York", "population": 8419000})");
+
+    const auto document = Document::parseFile(filePath);
+    std::filesystem::remove(filePath);
+
+    EXPECT_EQ(document.root()["city"].asString(), "New York");
+    EXPECT_EQ(document.root()["population"].asInt64(), 8419000);
+}
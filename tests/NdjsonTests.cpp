@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <core/Ndjson.hpp>
+
+#include <algorithm>
+#include <string>
+
+namespace {
+    std::string makeLog(const int records) {
+        std::string log;
+        for (int i = 0; i < records; ++i) {
+            log += R"({"id": )" + std::to_string(i) + R"(, "event": "click", "tags": ["a", "b"]})" + (i % 3 ? "\n" : "\r\n");
+        }
+        return log;
+    }
+
+    int64_t idOf(const std::shared_ptr<JsonValue> &value) {
+        return std::get<int64_t>(std::get<JsonObject>(value->value()).at("id")->value());
+    }
+}
+
+TEST(NdjsonTests, ParsesRecordsInOrder) {
+    NdjsonOptions options;
+    options.threads = 4;
+    options.batchBytes = 64;
+
+    const auto values = parseNdjson(makeLog(500), options);
+
+    ASSERT_EQ(values.size(), 500);
+    for (int i = 0; i < 500; ++i) {
+        EXPECT_EQ(idOf(values[i]), i);
+    }
+}
+
+TEST(NdjsonTests, UnorderedDeliversEveryRecord) {
+    NdjsonOptions options;
+    options.threads = 3;
+    options.batchBytes = 100;
+    options.ordered = false;
+
+    std::vector<int64_t> ids;
+    parseNdjson(makeLog(300), [&](NdjsonRecord &&record) { ids.push_back(idOf(record.value)); }, options);
+
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(ids.size(), 300);
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_EQ(ids[i], i);
+    }
+}
+
+TEST(NdjsonTests, ReportsMalformedLinesAndSkipsBlankOnes) {
+    const std::string input = "[1]\n\n  \n{\"a\": }\n\"last\" 2\ntrue";
+
+    std::vector<NdjsonRecord> records;
+    parseNdjson(input, [&](NdjsonRecord &&record) { records.push_back(std::move(record)); });
+
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_TRUE(records[0].value);
+    EXPECT_FALSE(records[1].value);
+    EXPECT_EQ(records[1].offset, 8);
+    EXPECT_EQ(records[1].error, "Unexpected token at column 7");
+    EXPECT_FALSE(records[2].value);
+    EXPECT_EQ(records[2].error, "Unexpected content after value at column 8");
+    EXPECT_EQ(std::get<bool>(records[3].value->value()), true);
+
+    EXPECT_THROW(parseNdjson(input), std::runtime_error);
+}
+
+TEST(NdjsonTests, RunsOnExistingPool) {
+    WorkerPool pool(2);
+    NdjsonOptions options;
+    options.pool = &pool;
+    options.batchBytes = 32;
+
+    EXPECT_EQ(parseNdjson(makeLog(50), options).size(), 50);
+    EXPECT_EQ(parseNdjson(makeLog(20), options).size(), 20);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <core/ParallelArray.hpp>
+#include <core/StructuralIndex.hpp>
+#include <core/Writer.hpp>
+
+#include <string>
+
+namespace {
+    ParallelArrayOptions smallChunks() {
+        ParallelArrayOptions options;
+        options.threads = 3;
+        options.chunkBytes = 16;
+        return options;
+    }
+}
+
+TEST(ParallelArrayTests, FindsTopLevelSeparators) {
+    const std::string json = R"( [1, {"a,]": [2, 3]}, "x\",[", [], 4] )";
+    const auto separators = StructuralIndex::topLevelSeparators(json);
+    ASSERT_EQ(separators.size(), 6);
+    EXPECT_EQ(json[separators[0]], '[');
+    EXPECT_EQ(separators[1], json.find(','));
+    EXPECT_EQ(json[separators[5]], ']');
+    EXPECT_EQ(separators[5], json.size() - 2);
+}
+
+TEST(ParallelArrayTests, MatchesSequentialParse) {
+    std::string json = "[";
+    for (int i = 0; i < 500; ++i) {
+        json += R"({"id":)" + std::to_string(i) + R"(,"tags":["a,b","]{[\",\"\\"],"nested":{"v":[)" + std::to_string(i * 2) + "]}},";
+        json += i % 7 == 0 ? "null,\n" : "";
+    }
+    json += "\"last\"]";
+
+    Parser parser(json);
+    const std::string expected = toJson(*parser.parse());
+    EXPECT_EQ(toJson(*parseArrayParallel(json, smallChunks())), expected);
+
+    ParallelArrayOptions oneChunk = smallChunks();
+    oneChunk.chunkBytes = json.size() / 2;
+    EXPECT_EQ(toJson(*parseArrayParallel(json, oneChunk)), expected);
+
+    WorkerPool pool(2);
+    ParallelArrayOptions shared = smallChunks();
+    shared.pool = &pool;
+    EXPECT_EQ(toJson(*parseArrayParallel(json, shared)), expected);
+}
+
+TEST(ParallelArrayTests, HandlesOtherRoots) {
+    EXPECT_EQ(toJson(*parseArrayParallel("  [   ]   ", smallChunks())), "[]");
+    const auto object = parseArrayParallel(R"({"key": [1, 2, 3], "other": "value"})", smallChunks());
+    EXPECT_EQ(toJson(*std::get<JsonObject>(object->value()).at("key")), "[1,2,3]");
+    EXPECT_EQ(toJson(*std::get<JsonObject>(object->value()).at("other")), R"("value")");
+    EXPECT_EQ(toJson(*parseArrayParallel("[[1,2],[3,4],[5,6],[7,8]]", smallChunks())), "[[1,2],[3,4],[5,6],[7,8]]");
+}
+
+TEST(ParallelArrayTests, RejectsMalformedArrays) {
+    const auto options = smallChunks();
+    EXPECT_THROW(parseArrayParallel("[1, 2, 3, 4, 5, 6, 7,, 8]", options), std::runtime_error);
+    EXPECT_THROW(parseArrayParallel("[1, 2, 3, 4, 5, 6, 7, 8,]", options), std::runtime_error);
+    EXPECT_THROW(parseArrayParallel("[1, 2, 3, 4, 5, 6, 7 8]", options), std::runtime_error);
+    EXPECT_THROW(parseArrayParallel("[1, 2, 3, 4, 5, 6, 7, 8] [9]", options), std::runtime_error);
+    EXPECT_THROW(parseArrayParallel("[1, 2, 3, 4, 5, 6, 7, 8", options), std::runtime_error);
+    EXPECT_THROW(parseArrayParallel(R"([1, 2, 3, 4, 5, 6, "7, 8])", options), std::runtime_error);
+}
+
+TEST(ParallelArrayTests, LocatesErrorsInTheWholeInput) {
+    const auto errorIn = [](const std::string& json) {
+        try {
+            parseArrayParallel(json, smallChunks());
+        } catch (const ParseException& exception) {
+            return exception.error();
+        }
+        ADD_FAILURE() << "expected a ParseException: " << json;
+        return ParseError{};
+    };
+
+    ParseError error = errorIn("[1, 2, 3, 4, 5, 6, 7,\n  8 9, 10, 11, 12, 13, 14, 15, 16]");
+    EXPECT_EQ(error.code, ParseErrorCode::ExpectedCommaOrEnd);
+    EXPECT_EQ(error.line, 2u);
+    EXPECT_EQ(error.column, 5u);
+
+    error = errorIn("[1, 2, 3, 4, 5, 6, 7,\n  [1, -], 8, 9, 10, 11, 12, 13, 14]");
+    EXPECT_EQ(error.code, ParseErrorCode::InvalidNumber);
+    EXPECT_EQ(error.line, 2u);
+    EXPECT_EQ(error.column, 7u);
+
+    error = errorIn("[1, 2, 3, 4, 5, 6, 7,\n  {\"a\": }, 8, 9, 10, 11, 12, 13, 14]");
+    EXPECT_EQ(error.line, 2u);
+    EXPECT_EQ(error.column, 9u);
+
+    error = errorIn("[1, 2, 3, 4, 5, 6, 7, 8, 9, 10] 11");
+    EXPECT_EQ(error.code, ParseErrorCode::TrailingContent);
+    EXPECT_EQ(error.column, 33u);
+}
+
+TEST(ParallelArrayTests, LimitsDepthLikeTheParser) {
+    const auto nested = [](const size_t depth) {
+        return "[1, 2, 3, " + std::string(depth, '[') + std::string(depth, ']') + "]";
+    };
+
+    const std::string deepest = nested(SaxReader<NullHandler>::MaxDepth - 1);
+    EXPECT_NO_THROW(Parser(deepest).parse());
+    EXPECT_NO_THROW(parseArrayParallel(deepest, smallChunks()));
+
+    const std::string tooDeep = nested(SaxReader<NullHandler>::MaxDepth);
+    EXPECT_THROW(Parser(tooDeep).parse(), ParseException);
+    try {
+        parseArrayParallel(tooDeep, smallChunks());
+        FAIL() << "expected a ParseException";
+    } catch (const ParseException& exception) {
+        EXPECT_EQ(exception.error().code, ParseErrorCode::TooDeep);
+    }
+}
+
+TEST(ParallelArrayTests, RunsFromATaskOnTheSamePool) {
+    std::string json = "[";
+    for (int i = 0; i < 200; ++i) {
+        json += std::to_string(i) + ",";
+    }
+    json += "200]";
+
+    WorkerPool pool(1);
+    ParallelArrayOptions options = smallChunks();
+    options.pool = &pool;
+    const auto result = pool.submit([&] { return parseArrayParallel(json, options); }).get();
+    EXPECT_EQ(toJson(*result), toJson(*Parser(json).parse()));
+}
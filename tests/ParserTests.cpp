@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <core/Parser.hpp>
+#include <core/ParserPool.hpp>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
@@ -47,7 +48,7 @@ TEST_F(ParserTestFixture, SimpleTypes) {
 
     ASSERT_EQ(obj.size(), 4);
     EXPECT_EQ(std::get<std::string>(obj.at("string")->value()), "value");
-    EXPECT_EQ(std::get<double>(obj.at("number")->value()), 42);
+    EXPECT_EQ(std::get<int64_t>(obj.at("number")->value()), 42);
     EXPECT_EQ(std::get<bool>(obj.at("boolean")->value()), true);
     EXPECT_EQ(std::get<std::nullptr_t>(obj.at("null")->value()), nullptr);
 }
@@ -70,7 +71,7 @@ TEST_F(ParserTestFixture, NestedObject) {
     ASSERT_TRUE(std::holds_alternative<JsonObject>(obj.at("nested")->value()));
     auto &nestedObj = std::get<JsonObject>(obj.at("nested")->value());
     EXPECT_EQ(std::get<std::string>(nestedObj.at("key")->value()), "value");
-    EXPECT_EQ(std::get<double>(nestedObj.at("number")->value()), 123);
+    EXPECT_EQ(std::get<int64_t>(nestedObj.at("number")->value()), 123);
 }
 
 TEST_F(ParserTestFixture, Array) {
@@ -84,7 +85,7 @@ TEST_F(ParserTestFixture, Array) {
     auto &array = std::get<JsonArray>(root->value());
 
     ASSERT_EQ(array.size(), 5);
-    EXPECT_EQ(std::get<double>(array[0]->value()), 1);
+    EXPECT_EQ(std::get<int64_t>(array[0]->value()), 1);
     EXPECT_EQ(std::get<std::string>(array[1]->value()), "text");
     EXPECT_EQ(std::get<bool>(array[2]->value()), false);
     EXPECT_EQ(std::get<std::nullptr_t>(array[3]->value()), nullptr);
@@ -121,7 +122,7 @@ TEST_F(ParserTestFixture, LargeNestedObject) {
     ASSERT_TRUE(std::holds_alternative<JsonObject>(obj.at("user")->value()));
     const auto& userObj = std::get<JsonObject>(obj.at("user")->value());
 
-    EXPECT_EQ(std::get<double>(userObj.at("id")->value()), 123);
+    EXPECT_EQ(std::get<int64_t>(userObj.at("id")->value()), 123);
     EXPECT_EQ(std::get<std::string>(userObj.at("name")->value()), "John Doe");
     EXPECT_EQ(std::get<bool>(userObj.at("isActive")->value()), true);
 
@@ -154,7 +155,7 @@ TEST_F(ParserTestFixture, MixedArrayTypes) {
     const auto& array = std::get<JsonArray>(root->value());
     ASSERT_EQ(array.size(), 6);
 
-    EXPECT_EQ(std::get<double>(array[0]->value()), 42);
+    EXPECT_EQ(std::get<int64_t>(array[0]->value()), 42);
     EXPECT_EQ(std::get<std::string>(array[1]->value()), "string");
     EXPECT_EQ(std::get<bool>(array[2]->value()), true);
     EXPECT_EQ(std::get<std::nullptr_t>(array[3]->value()), nullptr);
@@ -163,9 +164,9 @@ TEST_F(ParserTestFixture, MixedArrayTypes) {
     ASSERT_TRUE(std::holds_alternative<JsonArray>(array[4]->value()));
     const auto& nestedArray = std::get<JsonArray>(array[4]->value());
     ASSERT_EQ(nestedArray.size(), 3);
-    EXPECT_EQ(std::get<double>(nestedArray[0]->value()), 1);
-    EXPECT_EQ(std::get<double>(nestedArray[1]->value()), 2);
-    EXPECT_EQ(std::get<double>(nestedArray[2]->value()), 3);
+    EXPECT_EQ(std::get<int64_t>(nestedArray[0]->value()), 1);
+    EXPECT_EQ(std::get<int64_t>(nestedArray[1]->value()), 2);
+    EXPECT_EQ(std::get<int64_t>(nestedArray[2]->value()), 3);
 
 
     ASSERT_TRUE(std::holds_alternative<JsonObject>(array[5]->value()));
@@ -190,7 +191,7 @@ TEST(ParserTests, ParseFromFile) {
     auto& obj = std::get<JsonObject>(root->value());
 
     EXPECT_EQ(std::get<std::string>(obj.at("city")->value()), "New York");
-    EXPECT_EQ(std::get<double>(obj.at("population")->value()), 8419000);
+    EXPECT_EQ(std::get<int64_t>(obj.at("population")->value()), 8419000);
 
     auto& coords = std::get<JsonArray>(obj.at("coordinates")->value());
     ASSERT_EQ(coords.size(), 2);
@@ -212,7 +213,149 @@ TEST(ParserTests, InvalidJsonInFile) {
 
     createTestFile(filePath, invalidJson);
 
-    EXPECT_THROW(Parser(filePath, true), std::runtime_error);
+    Parser parser(filePath, true);
+    EXPECT_THROW(parser.parse(), std::runtime_error);
 
     std::filesystem::remove(filePath);
 }
+
+TEST(ParserTests, ParseFromStringPullsTokensLazily) {
+    Parser parser(R"({"values": [1, 2, {"nested": [true, null]}], "name": "pull"})");
+    const auto root = parser.parse();
+
+    const auto &obj = std::get<JsonObject>(root->value());
+    const auto &values = std::get<JsonArray>(obj.at("values")->value());
+    ASSERT_EQ(values.size(), 3);
+    EXPECT_EQ(std::get<int64_t>(values[1]->value()), 2);
+    const auto &nested = std::get<JsonArray>(std::get<JsonObject>(values[2]->value()).at("nested")->value());
+    EXPECT_EQ(std::get<bool>(nested[0]->value()), true);
+    EXPECT_EQ(std::get<std::string>(obj.at("name")->value()), "pull");
+}
+
+TEST(ParserTests, TruncatedInput) {
+    Parser parser("[1, 2,");
+    EXPECT_THROW(parser.parse(), std::runtime_error);
+}
+
+TEST(ParserTests, NumbersKeepIntegerPrecision) {
+    Parser parser(R"([9007199254740993, 18446744073709551615, 18446744073709551616, -0, 1e-400, 2.5E+3])");
+    const auto root = parser.parse();
+    const auto &array = std::get<JsonArray>(root->value());
+
+    EXPECT_EQ(std::get<int64_t>(array[0]->value()), 9007199254740993);
+    EXPECT_EQ(std::get<uint64_t>(array[1]->value()), 18446744073709551615ULL);
+    EXPECT_EQ(std::get<double>(array[2]->value()), 18446744073709551616.0);
+    EXPECT_EQ(std::get<int64_t>(array[3]->value()), 0);
+    EXPECT_EQ(std::get<double>(array[4]->value()), 0.0);
+    EXPECT_EQ(std::get<double>(array[5]->value()), 2500.0);
+}
+
+TEST(ParserTests, MalformedNumbers) {
+    for (const char *json: {"1-2e", "01", "1.", "-", "1e", "1e+", "--1", "1.2.3"}) {
+        Parser parser(json);
+        EXPECT_THROW(parser.parse(), std::runtime_error) << json;
+    }
+
+    Parser overflow("[1,\n  1e400]");
+    try {
+        overflow.parse();
+        FAIL() << "expected a ParseException";
+    } catch (const ParseException& exception) {
+        EXPECT_EQ(exception.error().code, ParseErrorCode::NumberOutOfRange);
+        EXPECT_EQ(exception.error().line, 2u);
+        EXPECT_EQ(exception.error().column, 3u);
+    }
+
+    Tokenizer tokenizer("[1, -1e400]");
+    const Tokenizer::TokenVector tokens = tokenizer.tokenize();
+    try {
+        Parser(tokens).parse();
+        FAIL() << "expected a ParseException";
+    } catch (const ParseException& exception) {
+        EXPECT_EQ(exception.error().code, ParseErrorCode::NumberOutOfRange);
+        EXPECT_EQ(exception.error().offset, 4u);
+    }
+
+    // Given the text, pre-tokenized input is located like text.
+    const std::string text = "{\"a\":\n  }";
+    const Tokenizer::TokenVector objectTokens = Tokenizer(text).tokenize();
+    try {
+        Parser(objectTokens, text).parse();
+        FAIL() << "expected a ParseException";
+    } catch (const ParseException& exception) {
+        EXPECT_EQ(exception.error().code, ParseErrorCode::UnexpectedToken);
+        EXPECT_EQ(exception.error().line, 2u);
+        EXPECT_EQ(exception.error().column, 3u);
+    }
+    const Tokenizer::TokenVector cut = Tokenizer("[1,").tokenize();
+    try {
+        Parser(cut, "[1,").parse();
+        FAIL() << "expected a ParseException";
+    } catch (const ParseException& exception) {
+        EXPECT_EQ(exception.error().code, ParseErrorCode::UnexpectedEnd);
+        EXPECT_EQ(exception.error().column, 4u);
+    }
+}
+
+TEST(ParserTests, RejectsTrailingContent) {
+    Parser parser("{\"a\": 1}\n  {\"b\": 2}");
+    try {
+        parser.parse();
+        FAIL() << "expected a ParseException";
+    } catch (const ParseException& exception) {
+        EXPECT_EQ(exception.error().code, ParseErrorCode::TrailingContent);
+        EXPECT_EQ(exception.error().line, 2u);
+        EXPECT_EQ(exception.error().column, 3u);
+    }
+}
+
+TEST(ParserTests, ResetReusesParser) {
+    Parser parser;
+    EXPECT_THROW(parser.parse(), ParseException);
+
+    parser.reset(R"({"name": "first", "items": [1, 2")");
+    EXPECT_THROW(parser.parse(), ParseException);
+
+    parser.reset(R"({"name": "se\u0063ond", "items": [1, 2, 3]})");
+    auto object = std::get<JsonObject>(parser.parse()->value());
+    EXPECT_EQ(std::get<std::string>(object["name"]->value()), "second");
+    EXPECT_EQ(std::get<JsonArray>(object["items"]->value()).size(), 3);
+
+    const std::string filePath = "reused.json";
+    createTestFile(filePath, "[true, null]");
+    parser.reset(filePath, true);
+    EXPECT_EQ(std::get<JsonArray>(parser.parse()->value()).size(), 2);
+    fs::remove(filePath);
+
+    Tokenizer tokenizer("42");
+    const auto tokens = tokenizer.tokenize();
+    parser.reset(tokens);
+    EXPECT_EQ(std::get<int64_t>(parser.parse()->value()), 42);
+
+    parser.reset("\"third\"");
+    EXPECT_EQ(std::get<std::string>(parser.parse()->value()), "third");
+}
+
+TEST(ParserTests, PoolHandsOutIdleParsers) {
+    const Parser* first;
+    {
+        auto lease = ParserPool::acquire("[1]");
+        first = &*lease;
+        EXPECT_EQ(std::get<JsonArray>(lease->parse()->value()).size(), 1);
+
+        // A nested parse gets a parser of its own.
+        auto nested = ParserPool::acquire("{}");
+        EXPECT_NE(&*nested, first);
+        EXPECT_TRUE(std::holds_alternative<JsonObject>(nested->parse()->value()));
+    }
+    EXPECT_EQ(ParserPool::idle(), 2);
+
+    std::vector<ParserPool::Lease> leases;
+    for (size_t i = 0; i < ParserPool::MaxIdle + 2; ++i) {
+        leases.push_back(ParserPool::acquire());
+    }
+    EXPECT_EQ(ParserPool::idle(), 0);
+    EXPECT_TRUE(&*leases[0] == first || &*leases[1] == first);
+    leases.clear();
+    EXPECT_EQ(ParserPool::idle(), ParserPool::MaxIdle);
+}
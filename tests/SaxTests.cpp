@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <core/Sax.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+    struct RecordingHandler {
+        std::vector<std::string> events;
+
+        bool onStartObject() { events.emplace_back("{"); return true; }
+        bool onKey(const std::string_view key) { events.push_back("key:" + std::string(key)); return true; }
+        bool onEndObject() { events.emplace_back("}"); return true; }
+        bool onStartArray() { events.emplace_back("["); return true; }
+        bool onEndArray() { events.emplace_back("]"); return true; }
+        bool onString(const std::string_view value) { events.push_back("string:" + std::string(value)); return true; }
+        bool onNumber(const std::string_view text) { events.push_back("number:" + std::string(text)); return true; }
+        bool onBoolean(const bool value) { events.push_back(value ? "true" : "false"); return true; }
+        bool onNull() { events.emplace_back("null"); return true; }
+    };
+
+    /**
+     * Stops as soon as the value of the first "id" key has been seen.
+     */
+    struct FindIdHandler {
+        std::string id;
+        bool wantValue = false;
+
+        bool onStartObject() { return true; }
+        bool onKey(const std::string_view key) { wantValue = key == "id"; return true; }
+        bool onEndObject() { return true; }
+        bool onStartArray() { return true; }
+        bool onEndArray() { return true; }
+        bool onString(const std::string_view value) { return capture(value); }
+        bool onNumber(const std::string_view text) { return capture(text); }
+        bool onBoolean(bool) { return capture("bool"); }
+        bool onNull() { return capture("null"); }
+
+        bool capture(const std::string_view value) {
+            if (!wantValue) {
+                return true;
+            }
+            id = value;
+            return false;
+        }
+    };
+}
+
+TEST(SaxTests, ReportsEventsInDocumentOrder) {
+    RecordingHandler handler;
+    EXPECT_TRUE(parseEvents(R"({"a": [1, "x", true, null], "b": {}})", handler));
+
+    const std::vector<std::string> expected = {
+        "{", "key:a", "[", "number:1", "string:x", "true", "null", "]", "key:b", "{", "}", "}"
+    };
+    EXPECT_EQ(handler.events, expected);
+}
+
+TEST(SaxTests, HandlerCanStopEarly) {
+    FindIdHandler handler;
+    EXPECT_FALSE(parseEvents(R"({"name": "n", "id": 42, "rest": [1, 2, 3 this is never tokenized)", handler));
+    EXPECT_EQ(handler.id, "42");
+}
+
+TEST(SaxTests, MalformedInputThrows) {
+    RecordingHandler handler;
+    EXPECT_THROW(parseEvents(R"({"a" 1})", handler), std::runtime_error);
+    EXPECT_THROW(parseEvents("[1, 2", handler), std::runtime_error);
+    EXPECT_THROW(parseEvents("", handler), std::runtime_error);
+}
+
+TEST(SaxTests, ParsesFromTokenSpan) {
+    const std::string json = "[false]";
+    Tokenizer tokenizer(json);
+    const auto tokenVector = tokenizer.tokenize();
+    TokenStream tokens(tokenVector);
+
+    RecordingHandler handler;
+    EXPECT_TRUE(parseEvents(tokens, handler));
+    EXPECT_EQ(handler.events, (std::vector<std::string>{"[", "false", "]"}));
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <core/Document.hpp>
+#include <core/ParserPool.hpp>
+#include <core/Stats.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+TEST(StatsTests, RecordsPhasesAndCounts) {
+    const std::string json = R"({"a": [1, 2, {"b": [true, null]}], "c": "text"})";
+    ParseStats stats;
+    auto root = parseWithStats(json, false, stats);
+    ASSERT_NE(root, nullptr);
+
+    EXPECT_EQ(stats.phase("read"), nullptr);
+    ASSERT_NE(stats.phase("tokenize"), nullptr);
+    ASSERT_NE(stats.phase("parse"), nullptr);
+    EXPECT_EQ(stats.phase("tokenize")->bytes, json.size());
+    EXPECT_EQ(stats.inputBytes, json.size());
+    EXPECT_EQ(stats.tokens, 23);
+    EXPECT_EQ(stats.nodes, 9);
+    EXPECT_EQ(stats.maxDepth, 4);
+
+    releaseWithStats(root, stats);
+    EXPECT_EQ(root, nullptr);
+    ASSERT_EQ(stats.phases.size(), 3);
+    EXPECT_EQ(stats.phases.back().name, "free");
+    EXPECT_GE(stats.totalMilliseconds(), stats.phase("parse")->milliseconds);
+
+    if constexpr (HeapStatsEnabled) {
+        EXPECT_GT(stats.phase("parse")->heap.allocations, 0u);
+        EXPECT_GT(stats.phase("parse")->heap.bytes, 0u);
+    } else {
+        EXPECT_EQ(stats.phase("parse")->heap.allocations, 0u);
+    }
+}
+
+TEST(StatsTests, ReadsFilesAsASeparatePhase) {
+    const auto path = std::filesystem::temp_directory_path() / "jsonparser-stats-test.json";
+    std::ofstream(path) << "[1, 2, 3]";
+
+    ParseStats stats;
+    parseWithStats(path.string(), true, stats);
+    std::filesystem::remove(path);
+
+    ASSERT_NE(stats.phase("read"), nullptr);
+    EXPECT_EQ(stats.phases.front().name, "read");
+    EXPECT_EQ(stats.phase("read")->bytes, 9);
+    EXPECT_EQ(stats.nodes, 4);
+    EXPECT_EQ(stats.maxDepth, 1);
+}
+
+TEST(StatsTests, JsonFormIsParseable) {
+    ParseStats stats;
+    auto root = parseWithStats("\"scalar\"", false, stats);
+    releaseWithStats(root, stats);
+
+    const auto report = Document::parse(stats.toJson());
+    EXPECT_EQ(report.root()["tokens"].asInt64(), 1);
+    EXPECT_EQ(report.root()["maxDepth"].asInt64(), 0);
+    ASSERT_EQ(report.root()["phases"].size(), 3);
+    EXPECT_EQ(report.root()["phases"][1]["name"].asString(), "parse");
+    EXPECT_EQ(report.root()["phases"][1]["allocations"].isNull(), !HeapStatsEnabled);
+    EXPECT_NE(stats.toText().find("max depth 0"), std::string::npos);
+}
+
+TEST(StatsTests, CountingHandlerForwardsEvents) {
+    DomBuilder builder;
+    CountingHandler<DomBuilder> counter(builder);
+    parseEvents(std::string_view("[[[]], {}]"), counter);
+
+    EXPECT_EQ(counter.nodes(), 4);
+    EXPECT_EQ(counter.maxDepth(), 3);
+    EXPECT_EQ(std::get<JsonArray>(builder.result()->value()).size(), 2);
+}
+
+TEST(StatsTests, ReportsMalformedInput) {
+    ParseStats stats;
+    EXPECT_THROW(parseWithStats("[1, 2", false, stats), ParseException);
+    EXPECT_THROW(parseWithStats("[1] 2", false, stats), ParseException);
+
+    // Located like a parse without stats.
+    try {
+        parseWithStats(R"({"a":})", false, stats);
+        FAIL() << "expected a ParseException";
+    } catch (const ParseException& exception) {
+        EXPECT_EQ(exception.error().code, ParseErrorCode::UnexpectedToken);
+        EXPECT_EQ(exception.error().line, 1u);
+        EXPECT_EQ(exception.error().column, 6u);
+    }
+}
+
+TEST(StatsTests, PooledParsersStopAllocating) {
+    if constexpr (!HeapStatsEnabled) {
+        GTEST_SKIP() << "needs a build with -DJSON_STATS=ON";
+    }
+
+    const std::string small = R"({"id": 7, "tags": ["a\nb", "c"], "ok": true})";
+    // Enough escaped strings to spread over several arena blocks.
+    std::string large = "[";
+    for (int i = 0; i < 200; ++i) {
+        large += (i > 0 ? ", \"" : "\"") + std::string(100, 'x') + "\\t\"";
+    }
+    large += "]";
+    const auto parseAll = [&] {
+        for (const std::string_view json: {std::string_view(large), std::string_view(small), std::string_view(small)}) {
+            auto parser = ParserPool::acquire(json);
+            NullHandler handler;
+            parser->parse(handler);
+        }
+    };
+
+    // One round grows every buffer, and the resets after the large document
+    // merge the decoded-string arena into a single block that fits it.
+    parseAll();
+    const HeapCounters before = heapCounters();
+    parseAll();
+    EXPECT_EQ((heapCounters() - before).allocations, 0);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <core/StreamingParser.hpp>
+
+namespace {
+    const std::string document = R"({"name": "streamed value", "id": 9007199254740993, "ratio": -1.25e-3,
+        "flags": [true, false, null], "nested": {"empty": {}, "list": []}})";
+
+    void expectDocument(const std::shared_ptr<JsonValue> &root) {
+        ASSERT_TRUE(root);
+        const auto &obj = std::get<JsonObject>(root->value());
+        EXPECT_EQ(std::get<std::string>(obj.at("name")->value()), "streamed value");
+        EXPECT_EQ(std::get<int64_t>(obj.at("id")->value()), 9007199254740993);
+        EXPECT_EQ(std::get<double>(obj.at("ratio")->value()), -1.25e-3);
+        const auto &flags = std::get<JsonArray>(obj.at("flags")->value());
+        ASSERT_EQ(flags.size(), 3);
+        EXPECT_EQ(std::get<bool>(flags[1]->value()), false);
+        const auto &nested = std::get<JsonObject>(obj.at("nested")->value());
+        EXPECT_TRUE(std::get<JsonObject>(nested.at("empty")->value()).empty());
+        EXPECT_TRUE(std::get<JsonArray>(nested.at("list")->value()).empty());
+    }
+}
+
+TEST(StreamingParserTests, EveryChunkSize) {
+    for (size_t chunkSize = 1; chunkSize <= document.size(); ++chunkSize) {
+        StreamingParser parser;
+        for (size_t pos = 0; pos < document.size(); pos += chunkSize) {
+            parser.feed(std::string_view(document).substr(pos, chunkSize));
+        }
+        parser.finish();
+
+        const auto values = parser.takeValues();
+        ASSERT_EQ(values.size(), 1) << chunkSize;
+        expectDocument(values[0]);
+    }
+}
+
+TEST(StreamingParserTests, EmitsValuesAsSoonAsTheyClose) {
+    std::vector<std::shared_ptr<JsonValue> > values;
+    StreamingParser parser([&](std::shared_ptr<JsonValue> value) { values.push_back(std::move(value)); });
+
+    parser.feed(R"([1, 2] {"a")");
+    ASSERT_EQ(values.size(), 1);
+    EXPECT_EQ(std::get<JsonArray>(values[0]->value()).size(), 2);
+
+    parser.feed(R"(: true} 12)");
+    ASSERT_EQ(values.size(), 2);
+
+    parser.feed("34 ");
+    ASSERT_EQ(values.size(), 3);
+    EXPECT_EQ(std::get<int64_t>(values[2]->value()), 1234);
+
+    parser.feed("nu");
+    parser.feed("ll");
+    EXPECT_EQ(values.size(), 3);
+    parser.finish();
+    ASSERT_EQ(values.size(), 4);
+    EXPECT_EQ(std::get<std::nullptr_t>(values[3]->value()), nullptr);
+}
+
+TEST(StreamingParserTests, Errors) {
+    StreamingParser truncated;
+    truncated.feed(R"({"key": [1, 2)");
+    EXPECT_THROW(truncated.finish(), std::runtime_error);
+
+    StreamingParser unterminated;
+    unterminated.feed(R"("abc)");
+    EXPECT_THROW(unterminated.finish(), std::runtime_error);
+
+    StreamingParser malformed;
+    EXPECT_THROW(malformed.feed(R"({"a" 1})"), std::runtime_error);
+
+    StreamingParser badNumber;
+    badNumber.feed("[1-");
+    EXPECT_THROW(badNumber.feed("2]"), std::runtime_error);
+
+    StreamingParser missingComma;
+    try {
+        missingComma.feed("[1 2]");
+        FAIL() << "expected a ParseException";
+    } catch (const ParseException& exception) {
+        EXPECT_EQ(exception.error().code, ParseErrorCode::ExpectedCommaOrEnd);
+    }
+}
+
+TEST(StreamingParserTests, LocatesErrorsInTheWholeStream) {
+    const auto errorOf = [](const std::string& json, const size_t chunkSize) {
+        StreamingParser parser;
+        try {
+            for (size_t i = 0; i < json.size(); i += chunkSize) {
+                parser.feed(std::string_view(json).substr(i, chunkSize));
+            }
+            parser.finish();
+        } catch (const ParseException& exception) {
+            return exception.error();
+        }
+        ADD_FAILURE() << "expected a ParseException";
+        return ParseError{};
+    };
+
+    const std::string json = "{\"a\": [1, 2],\n \"bb\": \"text\"}\n[3,\n  4 \"five\"]";
+    const size_t offset = json.find("\"five");
+    for (size_t chunkSize = 1; chunkSize <= json.size(); ++chunkSize) {
+        const ParseError error = errorOf(json, chunkSize);
+        EXPECT_EQ(error.code, ParseErrorCode::ExpectedCommaOrEnd) << chunkSize;
+        EXPECT_EQ(error.offset, offset) << chunkSize;
+        EXPECT_EQ(error.line, 4u) << chunkSize;
+        EXPECT_EQ(error.column, 5u) << chunkSize;
+    }
+
+    const ParseError truncated = errorOf("[1,\n 2", 3);
+    EXPECT_EQ(truncated.code, ParseErrorCode::UnexpectedEnd);
+    EXPECT_EQ(truncated.offset, 6u);
+    EXPECT_EQ(truncated.line, 2u);
+    EXPECT_EQ(truncated.column, 3u);
+
+    const ParseError badString = errorOf("[\"a\",\n \"b\\x\"]", 4);
+    EXPECT_EQ(badString.code, ParseErrorCode::InvalidEscape);
+    EXPECT_EQ(badString.line, 2u);
+    EXPECT_EQ(badString.column, 4u);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <core/StructuralIndex.hpp>
+#include <core/Tokenizer.hpp>
+
+#include <random>
+
+namespace {
+    constexpr StructuralIndex::Kernel kernels[] = {
+        StructuralIndex::Kernel::Scalar,
+        StructuralIndex::Kernel::Sse2,
+        StructuralIndex::Kernel::Avx2,
+    };
+
+    void expectSameTokens(const std::string &json) {
+        Tokenizer plain(json);
+        const auto expected = plain.tokenize();
+
+        for (const auto kernel: kernels) {
+            const StructuralIndex index(json, kernel);
+            Tokenizer indexed(json, index);
+            const auto tokens = indexed.tokenize();
+
+            ASSERT_EQ(tokens.size(), expected.size()) << json;
+            for (size_t i = 0; i < tokens.size(); ++i) {
+                EXPECT_EQ(tokens[i].type, expected[i].type) << json;
+                EXPECT_EQ(tokens[i].value, expected[i].value) << json;
+                EXPECT_EQ(tokens[i].offset, expected[i].offset) << json;
+            }
+        }
+    }
+}
+
+TEST(StructuralIndexTest, IndexesStructuralsQuotesAndScalarStarts) {
+    const std::string json = R"({"a": [12, true], "b{": null})";
+    const StructuralIndex index(json);
+
+    const std::vector<size_t> expected = {0, 1, 3, 4, 6, 7, 9, 11, 15, 16, 18, 21, 22, 24, 28};
+    EXPECT_EQ(index.positions(), expected);
+    EXPECT_FALSE(index.unterminatedString());
+}
+
+TEST(StructuralIndexTest, IgnoresEscapedQuotes) {
+    const std::string json = R"(["a\"b", "c\\", "d"])";
+    const StructuralIndex index(json);
+
+    const std::vector<size_t> expected = {0, 1, 6, 7, 9, 13, 14, 16, 18, 19};
+    EXPECT_EQ(index.positions(), expected);
+}
+
+TEST(StructuralIndexTest, DetectsUnterminatedString) {
+    const std::string json = R"({"key": "value)";
+    const StructuralIndex index(json);
+    EXPECT_TRUE(index.unterminatedString());
+
+    Tokenizer tokenizer(json, index);
+    EXPECT_THROW(tokenizer.tokenize(), std::runtime_error);
+}
+
+TEST(StructuralIndexTest, IndexedTokenizerMatchesByteWiseTokenizer) {
+    expectSameTokens("{}");
+    expectSameTokens("   [ 1 , -2.5e3 , \"x\" ]   ");
+    expectSameTokens(R"({"user": {"id": 123, "name": "John Doe", "roles": ["admin", "editor"], "active": false, "x": null}})");
+    expectSameTokens(std::string(70, ' ') + R"(["spans a block boundary", 1234567890123, "after"])" + std::string(60, '\n'));
+}
+
+TEST(StructuralIndexTest, KernelsAgreeOnRandomInput) {
+    std::mt19937 rng(42);
+    const std::string alphabet = "{}[]:,\"\\ \n\tab1-";
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+
+    for (int round = 0; round < 200; ++round) {
+        std::string json(1 + round * 3, ' ');
+        for (char &c: json) {
+            c = alphabet[pick(rng)];
+        }
+
+        const StructuralIndex scalar(json, StructuralIndex::Kernel::Scalar);
+        for (const auto kernel: kernels) {
+            const StructuralIndex other(json, kernel);
+            EXPECT_EQ(other.positions(), scalar.positions()) << json;
+            EXPECT_EQ(other.unterminatedString(), scalar.unterminatedString()) << json;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <core/TapeCache.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    void createTestFile(const std::string& filePath, const std::string& content) {
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to create test file: " + filePath);
+        }
+        file << content;
+    }
+
+    /**
+     * A fresh cache directory and source file, removed afterwards.
+     */
+    class TapeCacheTests : public testing::Test {
+    protected:
+        void SetUp() override {
+            std::filesystem::remove_all(directory);
+            createTestFile(path, R"({"name": "cached", "values": [1, 2.5, true, null], "nested": {"id": 7}})");
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(directory);
+            std::filesystem::remove(path);
+        }
+
+        const std::string directory = "tape_cache";
+        const std::string path = "tape_cache_source.json";
+    };
+}
+
+TEST_F(TapeCacheTests, MapsTheImageOnTheSecondLoad) {
+    const TapeCache cache(directory);
+
+    const CachedTape parsed = cache.load(path);
+    EXPECT_FALSE(parsed.fromCache());
+    EXPECT_TRUE(std::filesystem::exists(cache.imagePath(path)));
+
+    CachedTape mapped = cache.load(path);
+    EXPECT_TRUE(mapped.fromCache());
+    EXPECT_EQ(mapped.root()["name"].asString(), "cached");
+    EXPECT_EQ(mapped.root()["values"].size(), 4);
+    EXPECT_DOUBLE_EQ(mapped.root()["values"][1].asNumber(), 2.5);
+    EXPECT_EQ(mapped.root()["nested"]["id"].asInt64(), 7);
+    EXPECT_TRUE(std::ranges::equal(mapped.words(), parsed.words()));
+    EXPECT_EQ(mapped.strings(), parsed.strings());
+
+    // The views stay valid when the tape is moved.
+    const CachedTape moved = std::move(mapped);
+    EXPECT_EQ(moved.root()["name"].asString(), "cached");
+
+    cache.invalidate(path);
+    EXPECT_FALSE(std::filesystem::exists(cache.imagePath(path)));
+    EXPECT_FALSE(cache.load(path).fromCache());
+}
+
+TEST_F(TapeCacheTests, RebuildsWhenTheSourceChanges) {
+    const TapeCache cache(directory);
+    (void) cache.load(path);
+
+    createTestFile(path, R"({"name": "edited"})");
+    const CachedTape edited = cache.load(path);
+    EXPECT_FALSE(edited.fromCache());
+    EXPECT_EQ(edited.root()["name"].asString(), "edited");
+    EXPECT_TRUE(cache.load(path).fromCache());
+}
+
+TEST_F(TapeCacheTests, HashCatchesEditsThatKeepSizeAndTime) {
+    const TapeCache cache(directory);
+    (void) cache.load(path);
+
+    const auto time = std::filesystem::last_write_time(path);
+    createTestFile(path, R"({"name": "CACHED", "values": [1, 2.5, true, null], "nested": {"id": 7}})");
+    std::filesystem::last_write_time(path, time);
+
+    // Trusting size and time alone serves the stale image.
+    const TapeCache trusting(directory, {.verifyContent = false});
+    const CachedTape stale = trusting.load(path);
+    EXPECT_TRUE(stale.fromCache());
+    EXPECT_EQ(stale.root()["name"].asString(), "cached");
+
+    const CachedTape fresh = cache.load(path);
+    EXPECT_FALSE(fresh.fromCache());
+    EXPECT_EQ(fresh.root()["name"].asString(), "CACHED");
+}
+
+TEST_F(TapeCacheTests, RebuildsUnreadableImages) {
+    const TapeCache cache(directory);
+    (void) cache.load(path);
+    const std::string image = cache.imagePath(path);
+    const auto size = std::filesystem::file_size(image);
+
+    std::filesystem::resize_file(image, size - 1);
+    EXPECT_FALSE(cache.load(path).fromCache());
+    EXPECT_EQ(std::filesystem::file_size(image), size);
+
+    createTestFile(image, std::string(size, '\xff'));
+    const CachedTape rebuilt = cache.load(path);
+    EXPECT_FALSE(rebuilt.fromCache());
+    EXPECT_EQ(rebuilt.root()["nested"]["id"].asInt64(), 7);
+    EXPECT_TRUE(cache.load(path).fromCache());
+}
+
+TEST_F(TapeCacheTests, LoadsWithoutAWritableCache) {
+    // The directory cannot be created where a file already is.
+    createTestFile(directory, "");
+    const TapeCache cache(directory);
+    EXPECT_FALSE(cache.load(path).fromCache());
+    EXPECT_EQ(cache.load(path).root()["name"].asString(), "cached");
+}
+
+TEST_F(TapeCacheTests, ReportsErrors) {
+    const TapeCache cache(directory);
+    EXPECT_THROW((void) cache.load("missing.json"), std::runtime_error);
+
+    createTestFile(path, R"({"broken": [1, 2)");
+    EXPECT_THROW((void) cache.load(path), ParseException);
+    EXPECT_NE(contentHash("abc"), contentHash("abd"));
+    EXPECT_NE(contentHash(std::string(40, 'a')), contentHash(std::string(41, 'a')));
+}
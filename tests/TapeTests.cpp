@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <core/Tape.hpp>
+#include <core/Writer.hpp>
+
+#include <limits>
+#include <string>
+
+TEST(TapeTests, NavigateWithCursors) {
+    const auto tape = Tape::parse(R"(
+        {
+            "user": {
+                "id": 123,
+                "name": "John \"JD\" Doe",
+                "isActive": true,
+                "roles": ["admin", {"scope": [1, 2]}, "editor"],
+                "manager": null
+            }
+        }
+    )");
+
+    const TapeRef user = tape.root()["user"];
+    ASSERT_TRUE(user.isObject());
+    EXPECT_EQ(user.size(), 5);
+    EXPECT_EQ(user["id"].asInt64(), 123);
+    EXPECT_EQ(user["name"].asString(), "John \"JD\" Doe");
+    EXPECT_TRUE(user["isActive"].asBoolean());
+    EXPECT_TRUE(user["manager"].isNull());
+    EXPECT_EQ(user["roles"].size(), 3);
+    EXPECT_EQ(user["roles"][1]["scope"][1].asInt64(), 2);
+    EXPECT_EQ(user["roles"][2].asString(), "editor");
+    EXPECT_FALSE(user.find("missing"));
+    EXPECT_THROW(user["missing"], std::runtime_error);
+    EXPECT_THROW(user["roles"][3], std::runtime_error);
+    EXPECT_THROW((void) user["name"].asNumber(), std::runtime_error);
+    EXPECT_THROW((void) user["roles"].members(), std::runtime_error);
+}
+
+TEST(TapeTests, IteratesInDocumentOrder) {
+    const auto tape = Tape::parse(R"({"b": [], "a": {"x": {}}, "c": [1, [2, 3], 4]})");
+
+    std::string keys;
+    for (const auto& [key, value]: tape.root().members()) {
+        keys += key;
+    }
+    EXPECT_EQ(keys, "bac");
+
+    int64_t sum = 0;
+    for (const TapeRef element: tape.root()["c"].elements()) {
+        sum += element.isNumber() ? element.asInt64() : 10 * static_cast<int64_t>(element.size());
+    }
+    EXPECT_EQ(sum, 25);
+    EXPECT_EQ(tape.root()["b"].elements().begin(), tape.root()["b"].elements().end());
+}
+
+TEST(TapeTests, LaysOutValuesAsWords) {
+    const auto tape = Tape::parse(R"({"k": [true, 1.5]})");
+    const auto words = tape.words();
+    ASSERT_EQ(words.size(), 9);
+
+    EXPECT_EQ(TapeWord::tag(words[0]), TapeTag::ObjectStart);
+    EXPECT_EQ(TapeWord::payload(words[0]), 8);
+    EXPECT_EQ(TapeWord::tag(words[1]), TapeTag::String);
+    EXPECT_EQ(words[2], 1);
+    EXPECT_EQ(TapeWord::tag(words[3]), TapeTag::ArrayStart);
+    EXPECT_EQ(TapeWord::payload(words[3]), 4);
+    EXPECT_EQ(TapeWord::tag(words[4]), TapeTag::True);
+    EXPECT_EQ(TapeWord::tag(words[5]), TapeTag::Double);
+    EXPECT_EQ(TapeWord::tag(words[7]), TapeTag::ArrayEnd);
+    EXPECT_EQ(TapeWord::payload(words[7]), 2);
+    EXPECT_EQ(TapeWord::payload(words[8]), 1);
+    EXPECT_EQ(tape.strings(), "k");
+}
+
+TEST(TapeTests, PreservesNumbers) {
+    const auto tape = Tape::parse(R"([9007199254740993, 18446744073709551615, -5, 2.5])");
+    const TapeRef root = tape.root();
+
+    EXPECT_EQ(root[0].asInt64(), 9007199254740993);
+    EXPECT_EQ(root[1].asUInt64(), std::numeric_limits<uint64_t>::max());
+    EXPECT_THROW((void) root[1].asInt64(), std::runtime_error);
+    EXPECT_EQ(root[2].asInt64(), -5);
+    EXPECT_THROW((void) root[2].asUInt64(), std::runtime_error);
+    EXPECT_EQ(root[3].numberType(), NumberType::Double);
+    EXPECT_EQ(root[3].asNumber(), 2.5);
+}
+
+TEST(TapeTests, CopiesAndConverts) {
+    const std::string json = R"({"name":"tape","list":[1,2.5,true,null,"x"],"nested":{"a":[]}})";
+    auto tape = std::make_unique<Tape>(Tape::parse(std::string(json)));
+    const Tape copy = *tape;
+    tape.reset();
+
+    EXPECT_EQ(toJson(*toJsonValue(copy.root())), toJson(*Parser(json).parse()));
+    EXPECT_EQ(copy.memoryUsage(), copy.words().size() * sizeof(uint64_t) + copy.strings().size());
+}
+
+TEST(TapeTests, ReportsErrors) {
+    EXPECT_THROW(Tape::parse(R"({"a": [1, 2)"), ParseException);
+
+    const auto overflow = Tape::tryParse("[1, 1e400]");
+    ASSERT_FALSE(overflow.has_value());
+    EXPECT_EQ(overflow.error().code, ParseErrorCode::NumberOutOfRange);
+    EXPECT_EQ(overflow.error().column, 5);
+
+    const auto trailing = Tape::tryParse("{} {}");
+    ASSERT_FALSE(trailing.has_value());
+    EXPECT_EQ(trailing.error().code, ParseErrorCode::TrailingContent);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <core/Tokenizer.hpp>
 
+#include <set>
+#include <string>
+
 TEST(TokenizerTest, EmptyJSON) {
     const std::string json = "{}";
     Tokenizer tokenizer(json);
@@ -52,3 +55,127 @@ TEST(TokenizerTest, InvalidJSON) {
     Tokenizer tokenizer(json);
     EXPECT_THROW(tokenizer.tokenize(), std::runtime_error);
 }
+
+TEST(TokenizerTest, TokensReferToInputBuffer) {
+    const std::string json = R"({"key": [12, true]})";
+    Tokenizer tokenizer(json);
+    const auto tokens = tokenizer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 9);
+    EXPECT_EQ(tokens[1].value, "key");
+    EXPECT_EQ(tokens[1].value.data(), json.data() + 2);
+    EXPECT_EQ(tokens[1].offset, 1);
+    EXPECT_EQ(tokens[4].value, "12");
+    EXPECT_EQ(tokens[4].value.data(), json.data() + tokens[4].offset);
+}
+
+TEST(TokenizerTest, NextPullsOneTokenAtATime) {
+    const std::string json = "[null, 1]  ";
+    Tokenizer tokenizer(json);
+
+    EXPECT_EQ(tokenizer.next().type, TokenType::LeftBracket);
+    EXPECT_EQ(tokenizer.next().type, TokenType::Null);
+    EXPECT_EQ(tokenizer.next().type, TokenType::Comma);
+    EXPECT_EQ(tokenizer.next().value, "1");
+    EXPECT_EQ(tokenizer.next().type, TokenType::RightBracket);
+    EXPECT_EQ(tokenizer.next().type, TokenType::End);
+    EXPECT_EQ(tokenizer.next().type, TokenType::End);
+}
+
+TEST(TokenizerTest, RecordsErrorsInsteadOfThrowing) {
+    const std::string json = "[1,\n  nul]";
+    EXPECT_THROW(Tokenizer(json).tokenize(), ParseException);
+
+    Tokenizer tokenizer(json);
+    tokenizer.setRecordErrors(true);
+    EXPECT_EQ(tokenizer.tokenize().size(), 3);
+    EXPECT_EQ(tokenizer.next().type, TokenType::Error);
+    EXPECT_EQ(tokenizer.error().code, ParseErrorCode::InvalidKeyword);
+    EXPECT_EQ(tokenizer.error().offset, 6);
+}
+
+TEST(TokenizerTest, DecodesEscapes) {
+    const std::string json = R"(["a\"b\\c\/d\be\ff\ng\rh\ti", "\u00e9\u20AC\uD83D\uDE00", "plain", "x\u0041)" +
+                             std::string(40, 'y') + R"(\n"])";
+    Tokenizer tokenizer(json);
+    const auto tokens = tokenizer.tokenize();
+    ASSERT_EQ(tokens.size(), 9);
+
+    EXPECT_EQ(tokens[1].value, "a\"b\\c/d\be\ff\ng\rh\ti");
+    EXPECT_EQ(tokens[3].value, "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+    EXPECT_EQ(tokens[5].value, "plain");
+    EXPECT_EQ(tokens[5].value.data(), json.data() + tokens[5].offset + 1);
+    EXPECT_EQ(tokens[7].value, "xA" + std::string(40, 'y') + "\n");
+    EXPECT_EQ(tokens[7].offset, json.find("\"x"));
+}
+
+TEST(TokenizerTest, NextReusesTwoBuffersForDecodedStrings) {
+    std::string json = "[";
+    for (int i = 0; i < 10000; ++i) {
+        json += i == 0 ? R"("a\n)" : R"(, "a\n)";
+        json += std::to_string(i % 10) + '"';
+    }
+    json += "]";
+
+    Tokenizer tokenizer(json);
+    std::set<const char*> buffers;
+    Token last(TokenType::End, {});
+    std::string lastText;
+    int count = 0;
+    for (Token token = tokenizer.next(); token.type != TokenType::End; token = tokenizer.next()) {
+        if (token.type != TokenType::String) {
+            continue;
+        }
+        const std::string text = "a\n" + std::to_string(count++ % 10);
+        ASSERT_EQ(token.value, text);
+        // The string before stays intact while this one is read.
+        ASSERT_EQ(last.value, lastText);
+        buffers.insert(token.value.data());
+        last = token;
+        lastText = text;
+    }
+    EXPECT_EQ(count, 10000);
+    EXPECT_EQ(buffers.size(), 2u);
+}
+
+TEST(TokenizerTest, RejectsUnpairedSurrogates) {
+    for (const char* json : {R"("\uD83D")", R"("\uDE00\uD83D")", R"("\uD83DA")", R"("\uD83Dx")"}) {
+        Tokenizer tokenizer(json);
+        tokenizer.setRecordErrors(true);
+        EXPECT_EQ(tokenizer.next().type, TokenType::Error) << json;
+        EXPECT_EQ(tokenizer.error().code, ParseErrorCode::InvalidEscape) << json;
+    }
+}
+
+TEST(TokenizerTest, CanLeaveEscapesUndecoded) {
+    const std::string json = R"("a\nb")";
+    Tokenizer tokenizer(json);
+    tokenizer.setDecodeEscapes(false);
+    const Token token = tokenizer.next();
+    EXPECT_EQ(token.value, R"(a\nb)");
+    EXPECT_EQ(token.value.data(), json.data() + 1);
+}
+
+TEST(TokenizerTest, ResetStartsOverAndReusesStorage) {
+    Tokenizer tokenizer("[tru");
+    tokenizer.setRecordErrors(true);
+    Tokenizer::TokenVector tokens;
+    tokenizer.tokenize(tokens);
+    EXPECT_EQ(tokenizer.next().type, TokenType::Error);
+
+    const std::string first = R"(["a\nb", 1])";
+    tokenizer.reset(first);
+    tokenizer.tokenize(tokens);
+    ASSERT_EQ(tokens.size(), 5);
+    EXPECT_EQ(tokens[1].value, "a\nb");
+    const char* decoded = tokens[1].value.data();
+    const Token* buffer = tokens.data();
+
+    const std::string second = R"(["c\td"])";
+    tokenizer.reset(second);
+    tokenizer.tokenize(tokens);
+    ASSERT_EQ(tokens.size(), 3);
+    EXPECT_EQ(tokens[1].value, "c\td");
+    EXPECT_EQ(tokens[1].value.data(), decoded);
+    EXPECT_EQ(tokens.data(), buffer);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <core/Utf8.hpp>
+#include <core/Validate.hpp>
+
+#include <random>
+#include <string>
+
+namespace {
+    ParseErrorCode errorOf(const std::string_view json) {
+        const auto result = validate(json);
+        EXPECT_FALSE(result.has_value()) << json;
+        return result ? ParseErrorCode::UnexpectedEnd : result.error().code;
+    }
+
+    /**
+     * stringContentPrefix() one byte or sequence at a time.
+     */
+    size_t scalarContentPrefix(const std::string_view text) {
+        size_t i = 0;
+        while (i < text.size()) {
+            if (const auto c = static_cast<unsigned char>(text[i]); c < 0x80) {
+                if (c < 0x20 || c == '"' || c == '\\') {
+                    break;
+                }
+                ++i;
+            } else if (const size_t length = utf8SequenceLength(text.substr(i)); length > 0) {
+                i += length;
+            } else {
+                break;
+            }
+        }
+        return i;
+    }
+}
+
+TEST(ValidateTests, AcceptsWellFormedDocuments) {
+    for (const char* json : {R"({"a": [1, -2.5e3, true, false, null], "b": {"c": ""}})", "[]", "{}", "0",
+                             R"("a\"b\\c\/d\b\f\n\r\té😀")", "  [ 1 ]  \n"}) {
+        EXPECT_TRUE(validate(json).has_value()) << json;
+    }
+}
+
+TEST(ValidateTests, AcceptsMultiByteUtf8) {
+    EXPECT_TRUE(validate("[\"caf\xC3\xA9\", \"\xE2\x82\xAC\", \"\xF0\x9F\x98\x80\", \"\xF4\x8F\xBF\xBF\"]").has_value());
+}
+
+TEST(ValidateTests, RejectsInvalidUtf8) {
+    for (const char* json : {"\"\xC0\xAF\"",          // overlong '/'
+                             "\"\xE0\x80\xAF\"",      // overlong three-byte
+                             "\"\xED\xA0\x80\"",      // UTF-16 surrogate
+                             "\"\xF4\x90\x80\x80\"",  // above U+10FFFF
+                             "\"\xE2\x82\"",          // truncated sequence
+                             "\"\x80\"",              // lone continuation byte
+                             "\"\xFF\""}) {
+        EXPECT_EQ(errorOf(json), ParseErrorCode::InvalidUtf8) << json;
+    }
+}
+
+TEST(ValidateTests, RejectsBadEscapesAndControlCharacters) {
+    EXPECT_EQ(errorOf(R"("\x")"), ParseErrorCode::InvalidEscape);
+    EXPECT_EQ(errorOf(R"("\u12G4")"), ParseErrorCode::InvalidEscape);
+    EXPECT_EQ(errorOf(R"("\u12")"), ParseErrorCode::InvalidEscape);
+    EXPECT_EQ(errorOf("\"a\tb\""), ParseErrorCode::ControlCharacter);
+    EXPECT_EQ(errorOf(std::string_view("\"a\0b\"", 5)), ParseErrorCode::ControlCharacter);
+}
+
+TEST(ValidateTests, ReportsLocatedGrammarErrors) {
+    const auto result = validate("{\n  \"a\": 1,\n  \"b\" 2\n}");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, ParseErrorCode::ExpectedColon);
+    EXPECT_EQ(result.error().line, 3u);
+    EXPECT_EQ(result.error().column, 7u);
+
+    EXPECT_EQ(errorOf("[1, 2] 3"), ParseErrorCode::TrailingContent);
+    EXPECT_EQ(errorOf("[1, 2,]"), ParseErrorCode::UnexpectedToken);
+    EXPECT_EQ(errorOf("[1, 2"), ParseErrorCode::UnexpectedEnd);
+    EXPECT_EQ(errorOf("\"open"), ParseErrorCode::UnterminatedString);
+    EXPECT_EQ(errorOf("01"), ParseErrorCode::InvalidNumber);
+    EXPECT_EQ(errorOf("nul"), ParseErrorCode::InvalidKeyword);
+}
+
+TEST(ValidateTests, LimitsNestingDepth) {
+    const std::string ok = std::string(1000, '[') + std::string(1000, ']');
+    EXPECT_TRUE(validate(ok).has_value());
+
+    const std::string deep = std::string(100000, '[') + std::string(100000, ']');
+    EXPECT_EQ(errorOf(deep), ParseErrorCode::TooDeep);
+}
+
+TEST(ValidateTests, PlainStringPrefixStopsAtSpecialBytes) {
+    const std::string plain(40, 'x');
+    EXPECT_EQ(plainStringPrefix(plain), 40u);
+    EXPECT_EQ(plainStringPrefix(plain + "\"" + plain), 40u);
+    EXPECT_EQ(plainStringPrefix(plain + "\\n"), 40u);
+    EXPECT_EQ(plainStringPrefix(plain + "\n"), 40u);
+    EXPECT_EQ(plainStringPrefix(plain + "\xC3\xA9"), 40u);
+    EXPECT_EQ(plainStringPrefix("ab\x7F"), 3u);
+}
+
+TEST(ValidateTests, StringContentPrefixValidatesMultiByteText) {
+    const std::string text = std::string(30, 'x') + "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" + std::string(30, 'y');
+    EXPECT_EQ(stringContentPrefix(text), text.size());
+    EXPECT_EQ(stringContentPrefix(text + "\"" + text), text.size());
+    EXPECT_EQ(stringContentPrefix(text + "\xC3"), text.size());
+    EXPECT_EQ(stringContentPrefix(text + "\xED\xA0\x80" + text), text.size());
+    EXPECT_EQ(stringContentPrefix(text + "\xF4\x90\x80\x80" + text), text.size());
+    EXPECT_EQ(stringContentPrefix(text + "\xE0\x80\xAF" + text), text.size());
+
+    // Well-formed sequences of every length, with the odd special or
+    // invalid byte, at every alignment against the 32-byte blocks.
+    std::mt19937 random(12345);
+    const std::string pieces[] = {"a", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEF\xBF\xBF",
+                                  "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "\xC3\xA9", "z"};
+    const std::string faults[] = {"\"", "\\", "\n", "\x80", "\xC0\xAF", "\xC3", "\xE2\x82", "\xF5\x80\x80\x80",
+                                  "\xED\xB0\x80", "\xFF"};
+    for (int trial = 0; trial < 2000; ++trial) {
+        std::string input;
+        const size_t pieceCount = random() % 80;
+        for (size_t i = 0; i < pieceCount; ++i) {
+            input += random() % 40 == 0 ? faults[random() % std::size(faults)] : pieces[random() % std::size(pieces)];
+        }
+        ASSERT_EQ(stringContentPrefix(input), scalarContentPrefix(input)) << trial;
+    }
+}
+
+TEST(ValidateTests, ChecksUnicodeEscapes) {
+    EXPECT_TRUE(validate(R"(["é", "😀", "\u0000"])").has_value());
+    EXPECT_EQ(errorOf(R"("\uD83D")"), ParseErrorCode::InvalidEscape);
+    EXPECT_EQ(errorOf(R"("\uDE00")"), ParseErrorCode::InvalidEscape);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <core/Writer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    std::shared_ptr<JsonValue> parse(const std::string &json) {
+        Parser parser(json);
+        return parser.parse();
+    }
+}
+
+TEST(WriterTests, CompactOutput) {
+    const std::string json = R"([1,-2.5,"text",true,false,null,{"k":[]},{},18446744073709551615,1e+300])";
+    EXPECT_EQ(toJson(*parse(json)), R"([1,-2.5,"text",true,false,null,{"k":[]},{},18446744073709551615,1e+300])");
+}
+
+TEST(WriterTests, PrettyOutput) {
+    const auto document = Document::parse(R"({"a": 1, "b": [true, {"c": null}], "d": {}, "e": []})");
+
+    JsonWriter writer({.pretty = true, .indent = 2});
+    writer.write(document.root());
+    EXPECT_EQ(writer.str(), "{\n"
+                            "  \"a\": 1,\n"
+                            "  \"b\": [\n"
+                            "    true,\n"
+                            "    {\n"
+                            "      \"c\": null\n"
+                            "    }\n"
+                            "  ],\n"
+                            "  \"d\": {},\n"
+                            "  \"e\": []\n"
+                            "}");
+}
+
+TEST(WriterTests, EscapesStrings) {
+    JsonWriter writer;
+    writer.onString(std::string("quote\" backslash\\ newline\n tab\t bell\x07 nul") + '\0' + " long clean run of text é");
+    EXPECT_EQ(writer.str(), R"("quote\" backslash\\ newline\n tab\t bell\u0007 nul\u0000 long clean run of text é")");
+}
+
+TEST(WriterTests, DoublesRoundTrip) {
+    JsonWriter writer;
+    writer.onStartArray();
+    for (const double value: {0.1, 1.0 / 3.0, 2.0, -0.0, 5e-324, 1.7976931348623157e308}) {
+        writer.writeNumber(value);
+    }
+    writer.writeNumber(std::nan(""));
+    writer.onEndArray();
+    EXPECT_EQ(writer.str(), "[0.1,0.3333333333333333,2.0,-0.0,5e-324,1.7976931348623157e+308,null]");
+
+    const auto reparsed = std::get<JsonArray>(parse(writer.str())->value());
+    EXPECT_EQ(std::get<double>(reparsed[1]->value()), 1.0 / 3.0);
+    EXPECT_EQ(std::get<double>(reparsed[2]->value()), 2.0);
+}
+
+TEST(WriterTests, ReemitsParseEventsToFile) {
+    std::FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        JsonWriter writer = JsonWriter::toFile(file);
+        parseEvents(R"( { "a" : [ 1 , 2 ] } )", writer);
+        parseEvents(R"("second")", writer);
+    }
+
+    std::rewind(file);
+    char contents[64] = {};
+    const size_t n = std::fread(contents, 1, sizeof(contents) - 1, file);
+    std::fclose(file);
+    EXPECT_EQ(std::string(contents, n), "{\"a\":[1,2]}\n\"second\"");
+}
+
+TEST(WriterTests, FlushesLongFlatArrays) {
+    std::FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    size_t largest = 0;
+    {
+        JsonWriter writer = JsonWriter::toFile(file);
+        writer.onStartArray();
+        for (int64_t i = 0; i < 100000; ++i) {
+            writer.writeNumber(i);
+            writer.onBoolean(i % 2 == 0);
+            writer.onNull();
+            largest = std::max(largest, writer.str().size());
+        }
+        writer.onEndArray();
+    }
+
+    EXPECT_LT(largest, JsonWriter::FlushThreshold + 64);
+    std::fseek(file, 0, SEEK_END);
+    EXPECT_GT(std::ftell(file), static_cast<long>(10 * JsonWriter::FlushThreshold));
+    std::fclose(file);
+}